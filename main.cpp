@@ -1,27 +1,214 @@
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "src/TerminalUI/recorder.h"
 #include "src/TerminalUI/renderers/rowRenderer/row_renderer.hpp"
+#include "src/Dictionary/embedded_word_lists.hpp"
+#include "src/Dictionary/external_word_list.h"
+#include "src/Server/server.h"
 
 #include "src/game.cpp"
 
+// game with its own renderer bound to connection (word lists are shared by all sessions, they are read-only views)
+class GameSession final : public Server::Session {
+    WordlyTUI game;
+    TerminalUI::RowRenderer<WordlyTUI> renderer;
+
+    public:
+        GameSession(const Dictionary::WordList dictionary, const Dictionary::WordList answers, const GameOptions& options, TerminalUI::OutputSink& output, const TerminalUI::Dimension dimensions) :
+            game(dictionary, answers, options),
+            renderer(&game, &WordlyTUI::app_flow_control, &WordlyTUI::handle_interrupts, dimensions, &output) {}
+
+        void input(const std::string_view bytes) override { renderer.feedInput(bytes); }
+        void resize(const TerminalUI::Dimension dimensions) override { renderer.resize(dimensions); }
+        std::optional<TerminalUI::Clock::time_point> tick(const TerminalUI::Clock::time_point now) override { return renderer.tick(now); }
+        [[nodiscard]] bool finished() const override { return renderer.isStopped(); }
+};
+
+static Server::Server* running_server = nullptr;
+static void stop_server(int) {
+    if (running_server != nullptr) { running_server->stop(); }
+}
+
+static void print_usage(const char* program) {
+    std::cerr
+        << "Usage: " << program << " [options]\n"
+        << "  --dictionary <file>  word list used for validating guesses (default: embedded english list)\n"
+        << "  --answers <file>     word list used for choosing word to guess (default: embedded list, or --dictionary)\n"
+        << "  --length <4-8>       word length, requires --dictionary for other lengths than 5 (default: 5)\n"
+        << "  --guesses <n>        number of guesses (default: 6, or number of boards + 5)\n"
+        << "  --boards <1-32>      boards played at once, every guess goes to all of them (default: 1)\n"
+        << "  --adversarial        no word is chosen, every guess gets feedback that keeps the most words possible\n"
+        << "  --listen <address>   run as server for telnet clients, address is TCP port on localhost or path of Unix socket\n"
+        << "  --threads <n>        diff large frames (very big terminals) on n threads, 0 for all cores (default: 1)\n"
+        << "  --book <file>        opening book for hints, made by wordly_book (default: opening_book.db, if it exists)\n"
+        << "  --scoreboard <file>  file results are appended to (default: scoreboard.db)\n"
+        << "  --scoreboard-sync <none|batch|record>  when results are synced to disk (default: batch)\n"
+        << "  --record <file>      records terminal output into asciicast v2 file (not with --listen)\n"
+        << "  --record-frames      adds marker at the end of every frame to recording\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::optional<std::string> dictionary_path, answers_path, listen_address, book_path, record_path;
+    bool record_frames = false;
+    unsigned int word_length = Dictionary::Embedded::word_length;
+    unsigned int diff_threads = 1;
+    std::string scoreboard_path = "scoreboard.db";
+    std::optional<Scoreboard::SyncPolicy> scoreboard_sync = Scoreboard::SyncPolicy::BATCH;
+    GameOptions options;
+    std::optional<unsigned int> max_guesses;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--dictionary") == 0 && has_value) { dictionary_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--answers") == 0 && has_value) { answers_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--length") == 0 && has_value) { word_length = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--guesses") == 0 && has_value) { max_guesses = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--boards") == 0 && has_value) { options.board_count = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--adversarial") == 0) { options.adversarial = true; }
+        else if (std::strcmp(argv[i], "--listen") == 0 && has_value) { listen_address = argv[++i]; }
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value) { diff_threads = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--book") == 0 && has_value) { book_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--scoreboard") == 0 && has_value) { scoreboard_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--scoreboard-sync") == 0 && has_value) { scoreboard_sync = Scoreboard::Writer::parseSyncPolicy(argv[++i]); }
+        else if (std::strcmp(argv[i], "--record") == 0 && has_value) { record_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--record-frames") == 0) { record_frames = true; }
+        else { print_usage(argv[0]); return EXIT_FAILURE; }
+    }
+    // multi-board game gets one more guess for every extra board
+    options.max_guesses = max_guesses.value_or(options.board_count > 1 ? options.board_count + 5 : options.max_guesses);
+    if (options.max_guesses == 0 || options.board_count == 0 || options.board_count > 32 || (options.adversarial && options.board_count > 1)
+        || (record_path.has_value() && listen_address.has_value()) || !scoreboard_sync.has_value()) { print_usage(argv[0]); return EXIT_FAILURE; }
 
-int main(void) {
-    std::vector<std::string> english_5_word_dictionary = {
-         #include "src/resources/English.db"
+    /*
+     *  Embedded lists are normalized (lowercase, 5-letter only, sorted) at compile time, so nothing is copied here.
+     *  External lists are mapped from binary cache (created on first use), they need to live as long as the game.
+     */
+    Dictionary::WordList dictionary = Dictionary::Embedded::english_5_word_dictionary;
+    Dictionary::WordList answers = Dictionary::Embedded::wordle_answers_list;
+    std::unique_ptr<Dictionary::ExternalWordList> external_dictionary, external_answers;
+    try {
+        if (dictionary_path.has_value()) {
+            external_dictionary = std::make_unique<Dictionary::ExternalWordList>(dictionary_path.value(), word_length);
+            dictionary = external_dictionary->words();
+            // without separate answers list any dictionary word can be the one to guess
+            if (!answers_path.has_value()) { answers = dictionary; }
+        }
+        if (answers_path.has_value()) {
+            external_answers = std::make_unique<Dictionary::ExternalWordList>(answers_path.value(), word_length);
+            answers = external_answers->words();
+        }
+    } catch (const std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    // words with letters other than a-z can't be played, player should know that list got smaller
+    const auto report_skipped = [](const Dictionary::ExternalWordList* list, const std::optional<std::string>& path) {
+        if (list != nullptr && list->skipped_words() > 0) {
+            std::cerr << "Skipped " << list->skipped_words() << " words of " << path.value() << " with letters other than a-z" << std::endl;
+        }
     };
-    // convert to lowercase, TODO: just convert dict to all lowercase
-    for(int i = 0; i<english_5_word_dictionary.size(); i++){
-        for(auto& c : english_5_word_dictionary[i])
-        {
-            c = tolower(c);
+    report_skipped(external_dictionary.get(), dictionary_path);
+    report_skipped(external_answers.get(), answers_path);
+    if (dictionary.word_length() != word_length || answers.word_length() != word_length) {
+        std::cerr << "Embedded word lists have only " << Dictionary::Embedded::word_length << "-letter words, use --dictionary for other lengths" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (answers.empty()) {
+        std::cerr << "There are no " << word_length << "-letter words to guess" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // word graph is built once, games (and server sessions) share it
+    options.dictionary_graph = std::make_shared<const Dictionary::Dawg>(dictionary);
+    // first hint out of the book is computed by the first game that needs it
+    options.first_hint = std::make_shared<std::optional<std::size_t>>();
+    // hints out of the book are computed by one worker thread, local game scores them on all cores (server sessions share them)
+    options.hint_worker = std::make_shared<Solver::HintWorker>(listen_address.has_value() ? 1 : std::max(1u, std::thread::hardware_concurrency()));
+
+    // book is optional (hints are computed without it), only book given explicitly has to be valid
+    try {
+        options.opening_book = std::make_shared<const Solver::OpeningBook>(book_path.value_or("opening_book.db"));
+        if (!options.opening_book->matches(dictionary, answers)) {
+            options.opening_book.reset();
+            if (book_path.has_value()) { throw std::runtime_error("Opening book was made for other word lists: " + book_path.value()); }
+        }
+    } catch (const std::runtime_error &error) {
+        if (book_path.has_value()) {
+            std::cerr << error.what() << std::endl;
+            return EXIT_FAILURE;
         }
     }
 
-    std::vector<std::string> wordle_answers_list = {
-         #include "src/resources/wordle-answers.db"
+    // results of all games (and sessions) are appended by one writer thread
+    options.scoreboard = std::make_shared<Scoreboard::Writer>(scoreboard_path, scoreboard_sync.value());
+    // queued results are written before exit (one more attempt if writing keeps failing)
+    const auto close_scoreboard = [&options] {
+        if (const std::size_t lost = options.scoreboard->close(); lost > 0) {
+            std::cerr << lost << " results couldn't be saved: " << options.scoreboard->lastError().value_or("") << std::endl;
+        }
     };
 
-    auto game = WordlyTUI(english_5_word_dictionary, wordle_answers_list);
+    if (listen_address.has_value()) {
+        try {
+            Server::Server server(Server::Address::parse(listen_address.value()), [&](TerminalUI::OutputSink& output, const TerminalUI::Dimension dimensions) {
+                return std::make_unique<GameSession>(dictionary, answers, options, output, dimensions);
+            });
+            std::cerr << "Listening on " << server.listenAddress().toString() << std::endl;
 
-    auto terminal_engine = TerminalUI::RowRenderer<WordlyTUI>(&game, &WordlyTUI::app_flow_control, &WordlyTUI::handle_interrupts);
+            // server stops on Ctrl+C (so Unix socket file is removed)
+            running_server = &server;
+            struct sigaction action{};
+            action.sa_handler = stop_server;
+            sigaction(SIGINT, &action, nullptr);
+            sigaction(SIGTERM, &action, nullptr);
+
+            server.run();
+            running_server = nullptr;
+            // worker reads word lists, it's stopped before they are unmapped
+            options.hint_worker->close();
+            close_scoreboard();
+            if constexpr (Diagnostics::memory_accounting) { Diagnostics::printMemoryReport(std::cerr); }
+        } catch (const std::runtime_error &error) {
+            options.hint_worker->close();
+            std::cerr << error.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
 
-    terminal_engine.render(true);
-}
\ No newline at end of file
+    // recording outlives renderer, so it gets output of restoring the terminal too
+    std::unique_ptr<TerminalUI::AsciicastRecorder> recorder;
+    {
+        // server sessions share cores, only local game compares adversary's options on all of them
+        options.solver_threads = std::max(1u, std::thread::hardware_concurrency());
+        auto game = WordlyTUI(dictionary, answers, options);
+
+        auto terminal_engine = TerminalUI::RowRenderer<WordlyTUI>(&game, &WordlyTUI::app_flow_control, &WordlyTUI::handle_interrupts);
+
+        if (record_path.has_value()) {
+            try {
+                recorder = std::make_unique<TerminalUI::AsciicastRecorder>(record_path.value(), terminal_engine.screenSize(), record_frames);
+            } catch (const std::runtime_error &error) {
+                std::cerr << error.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+            terminal_engine.setRecorder(recorder.get());
+        }
+        terminal_engine.setDiffThreads(diff_threads);
+        terminal_engine.render(true);
+    }
+    options.hint_worker->close();
+    close_scoreboard();
+    if (recorder != nullptr) {
+        if (const std::size_t dropped = recorder->close(); dropped > 0) {
+            std::cerr << "Recording " << recorder->filePath() << " is missing " << dropped << " bytes (disk was too slow)" << std::endl;
+        }
+    }
+    // report goes below last frame (terminal is restored when renderer is destroyed)
+    if constexpr (Diagnostics::memory_accounting) { Diagnostics::printMemoryReport(std::cerr); }
+}
@@ -0,0 +1,180 @@
+#include "memory_accounting.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+
+namespace Diagnostics {
+    namespace {
+        // counters are constant-initialized, so allocations made before main() are counted too
+        struct Counters {
+            std::atomic<std::size_t> allocations{0};
+            std::atomic<std::size_t> allocated_bytes{0};
+            std::atomic<std::size_t> live_bytes{0};
+            std::atomic<std::size_t> peak_live_bytes{0};
+            std::atomic<std::size_t> frames_with_allocations{0};
+            std::atomic<std::size_t> max_frame_allocations{0};
+        };
+        std::array<Counters, subsystem_count> counters{};
+        std::atomic<std::size_t> frame_count{0};
+
+        void update_maximum(std::atomic<std::size_t>& maximum, const std::size_t value) {
+            std::size_t current = maximum.load(std::memory_order_relaxed);
+            while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        // "1.5 MiB" etc. into fixed buffer (report is printed when heap could be in any state)
+        const char* format_bytes(char (&text)[32], const std::size_t bytes) {
+            if (bytes >= 1024 * 1024) { std::snprintf(text, sizeof(text), "%.1f MiB", bytes / (1024.0 * 1024.0)); }
+            else if (bytes >= 1024) { std::snprintf(text, sizeof(text), "%.1f KiB", bytes / 1024.0); }
+            else { std::snprintf(text, sizeof(text), "%zu B", bytes); }
+            return text;
+        }
+
+        #ifdef WORDLY_MEMORY_ACCOUNTING
+            /*
+             *  Every block starts with header (size and subsystem that allocated it), so freeing it knows what to give back.
+             *  Header keeps default new alignment, over-aligned blocks put it right before aligned pointer.
+             */
+            struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader {
+                std::size_t size;
+                Subsystem subsystem;
+            };
+
+            void charge(BlockHeader* header, const std::size_t size) {
+                header->size = size;
+                header->subsystem = detail::current_subsystem;
+                Counters& counter = counters[static_cast<std::size_t>(header->subsystem)];
+                counter.allocations.fetch_add(1, std::memory_order_relaxed);
+                counter.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+                update_maximum(counter.peak_live_bytes, counter.live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+            }
+            void refund(const BlockHeader* header) {
+                counters[static_cast<std::size_t>(header->subsystem)].live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+            }
+
+            void* allocate(const std::size_t size) {
+                void* block = std::malloc(sizeof(BlockHeader) + size);
+                if (block == nullptr) { return nullptr; }
+                auto* header = static_cast<BlockHeader*>(block);
+                charge(header, size);
+                return header + 1;
+            }
+            void* allocate_aligned(const std::size_t size, const std::size_t alignment) {
+                // aligned_alloc needs size multiple of alignment, alignment is always bigger than header here
+                const std::size_t block_size = (alignment + size + alignment - 1) / alignment * alignment;
+                void* block = std::aligned_alloc(alignment, block_size);
+                if (block == nullptr) { return nullptr; }
+                void* pointer = static_cast<char*>(block) + alignment;
+                charge(static_cast<BlockHeader*>(pointer) - 1, size);
+                return pointer;
+            }
+        #endif
+    }
+
+    #ifdef WORDLY_MEMORY_ACCOUNTING
+        namespace detail { thread_local Subsystem current_subsystem = Subsystem::OTHER; }
+    #endif
+
+    AllocationSnapshot allocationSnapshot() {
+        AllocationSnapshot snapshot{};
+        for (std::size_t i = 0; i < subsystem_count; ++i) { snapshot[i] = counters[i].allocations.load(std::memory_order_relaxed); }
+        return snapshot;
+    }
+
+    FrameAllocations recordFrame(const AllocationSnapshot& before) {
+        frame_count.fetch_add(1, std::memory_order_relaxed);
+        FrameAllocations frame;
+        std::size_t top_allocations = 0;
+        for (std::size_t i = 0; i < subsystem_count; ++i) {
+            const std::size_t allocations = counters[i].allocations.load(std::memory_order_relaxed) - before[i];
+            if (allocations == 0) { continue; }
+            counters[i].frames_with_allocations.fetch_add(1, std::memory_order_relaxed);
+            update_maximum(counters[i].max_frame_allocations, allocations);
+            frame.allocations += allocations;
+            if (allocations > top_allocations) {
+                top_allocations = allocations;
+                frame.top_subsystem = static_cast<Subsystem>(i);
+            }
+        }
+        return frame;
+    }
+
+    SubsystemMemory subsystemMemory(const Subsystem subsystem) {
+        const Counters& counter = counters[static_cast<std::size_t>(subsystem)];
+        return {
+            counter.allocations.load(std::memory_order_relaxed),
+            counter.allocated_bytes.load(std::memory_order_relaxed),
+            counter.live_bytes.load(std::memory_order_relaxed),
+            counter.peak_live_bytes.load(std::memory_order_relaxed),
+            counter.frames_with_allocations.load(std::memory_order_relaxed),
+            counter.max_frame_allocations.load(std::memory_order_relaxed)
+        };
+    }
+
+    std::size_t liveBytes() {
+        std::size_t bytes = 0;
+        for (const Counters& counter : counters) { bytes += counter.live_bytes.load(std::memory_order_relaxed); }
+        return bytes;
+    }
+
+    std::size_t peakResidentBytes() {
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) { return 0; }
+        #ifdef __APPLE__
+            return static_cast<std::size_t>(usage.ru_maxrss);
+        #else
+            // kilobytes on Linux
+            return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+        #endif
+    }
+
+    void printMemoryReport(std::ostream& output) {
+        char line[160], allocated[32], live[32], peak[32];
+        output << "memory by subsystem:\n";
+        std::snprintf(line, sizeof(line), "  %-11s %12s %12s %12s %12s %10s %10s\n",
+            "subsystem", "allocations", "allocated", "live", "peak live", "frames", "max/frame");
+        output << line;
+        for (std::size_t i = 0; i < subsystem_count; ++i) {
+            const SubsystemMemory memory = subsystemMemory(static_cast<Subsystem>(i));
+            if (memory.allocations == 0) { continue; }
+            std::snprintf(line, sizeof(line), "  %-11.*s %12zu %12s %12s %12s %10zu %10zu\n",
+                static_cast<int>(subsystem_names[i].size()), subsystem_names[i].data(), memory.allocations,
+                format_bytes(allocated, memory.allocated_bytes), format_bytes(live, memory.live_bytes), format_bytes(peak, memory.peak_live_bytes),
+                memory.frames_with_allocations, memory.max_frame_allocations);
+            output << line;
+        }
+        // "frames" column is how many of all frames allocated anything, it should stay near zero when nothing changes on the screen
+        std::snprintf(line, sizeof(line), "frames: %zu, live heap: %s, peak RSS: %s\n",
+            frame_count.load(std::memory_order_relaxed), format_bytes(live, liveBytes()), format_bytes(peak, peakResidentBytes()));
+        output << line;
+    }
+}
+
+#ifdef WORDLY_MEMORY_ACCOUNTING
+    // other forms of new and delete (arrays, nothrow) forward to these by default
+    void* operator new(const std::size_t size) {
+        if (void* pointer = Diagnostics::allocate(size)) { return pointer; }
+        throw std::bad_alloc();
+    }
+    void* operator new(const std::size_t size, const std::align_val_t alignment) {
+        if (void* pointer = Diagnostics::allocate_aligned(size, static_cast<std::size_t>(alignment))) { return pointer; }
+        throw std::bad_alloc();
+    }
+    void operator delete(void* pointer) noexcept {
+        if (pointer == nullptr) { return; }
+        const auto* header = static_cast<Diagnostics::BlockHeader*>(pointer) - 1;
+        Diagnostics::refund(header);
+        std::free(const_cast<Diagnostics::BlockHeader*>(header));
+    }
+    void operator delete(void* pointer, const std::align_val_t alignment) noexcept {
+        if (pointer == nullptr) { return; }
+        Diagnostics::refund(static_cast<Diagnostics::BlockHeader*>(pointer) - 1);
+        std::free(static_cast<char*>(pointer) - static_cast<std::size_t>(alignment));
+    }
+    // sized forms have to be replaced too (compiler calls them directly), size is already in block header
+    void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+    void operator delete(void* pointer, std::size_t, const std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+#endif
@@ -0,0 +1,91 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace Diagnostics {
+    /*
+     *  Heap accounting by subsystem (instrumentation build only, cmake -DWORDLY_MEMORY_ACCOUNTING=ON).
+     *  Global operator new is replaced, and every allocation is charged to subsystem tagged on its thread by MemoryScope
+     *  (innermost scope wins, so game code called by renderer is charged to game). Freed memory goes back to subsystem that allocated it.
+     *  In normal builds scopes compile to nothing, and all counters stay at zero.
+     */
+    enum class Subsystem : std::uint8_t {
+        OTHER,
+        TERMINAL,    // framebuffers and frame output
+        RENDERER,    // rows, layers, input decoding
+        GAME,
+        DICTIONARY,  // word lists, word graph
+        SOLVER,      // hints
+        SCOREBOARD,
+        SERVER       // connections and sessions
+    };
+    constexpr std::size_t subsystem_count = 8;
+    constexpr std::array<std::string_view, subsystem_count> subsystem_names = {
+        "other", "terminal", "renderer", "game", "dictionary", "solver", "scoreboard", "server"
+    };
+
+    #ifdef WORDLY_MEMORY_ACCOUNTING
+        constexpr bool memory_accounting = true;
+        namespace detail { extern thread_local Subsystem current_subsystem; }
+    #else
+        constexpr bool memory_accounting = false;
+    #endif
+
+    [[nodiscard]] inline Subsystem currentSubsystem() {
+        #ifdef WORDLY_MEMORY_ACCOUNTING
+            return detail::current_subsystem;
+        #else
+            return Subsystem::OTHER;
+        #endif
+    }
+
+    // allocations made on this thread while scope lives are charged to subsystem
+    class MemoryScope {
+        #ifdef WORDLY_MEMORY_ACCOUNTING
+            Subsystem previous;
+
+            public:
+                explicit MemoryScope(const Subsystem subsystem) : previous(detail::current_subsystem) { detail::current_subsystem = subsystem; }
+                ~MemoryScope() { detail::current_subsystem = previous; }
+        #else
+            public:
+                explicit MemoryScope(Subsystem) {}
+        #endif
+            MemoryScope(const MemoryScope&) = delete;
+            MemoryScope& operator=(const MemoryScope&) = delete;
+    };
+
+    struct SubsystemMemory {
+        std::size_t allocations = 0;            // since start
+        std::size_t allocated_bytes = 0;        // since start
+        std::size_t live_bytes = 0;
+        std::size_t peak_live_bytes = 0;
+        std::size_t frames_with_allocations = 0;
+        std::size_t max_frame_allocations = 0;  // the most allocations in one frame
+    };
+
+    // allocation counts of all subsystems at some moment (frame is measured between two of them)
+    using AllocationSnapshot = std::array<std::size_t, subsystem_count>;
+    struct FrameAllocations {
+        std::size_t allocations = 0;
+        Subsystem top_subsystem = Subsystem::OTHER;  // subsystem that made most of them
+    };
+
+    [[nodiscard]] AllocationSnapshot allocationSnapshot();
+    // records allocations made since 'before' as one frame (per-frame allocations should be zero in steady state)
+    FrameAllocations recordFrame(const AllocationSnapshot& before);
+
+    [[nodiscard]] SubsystemMemory subsystemMemory(Subsystem subsystem);
+    [[nodiscard]] std::size_t liveBytes();
+    // peak resident set size of the process (works in all builds)
+    [[nodiscard]] std::size_t peakResidentBytes();
+
+    // table of all subsystems, peak RSS and frame count (printed at exit of instrumentation build)
+    void printMemoryReport(std::ostream& output);
+}
+
+#endif //MEMORY_ACCOUNTING_H
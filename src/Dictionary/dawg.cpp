@@ -0,0 +1,123 @@
+#include "dawg.h"
+#include "../Diagnostics/memory_accounting.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace Dictionary {
+    namespace {
+        struct Builder {
+            const WordList& words;
+            std::vector<std::uint32_t>& children;
+            std::vector<std::uint32_t> node_letters{};
+            std::vector<std::uint32_t> node_first_child{};
+            // nodes by their letters and children, node with the same ones is reused (that's what makes graph minimal)
+            std::unordered_map<std::string, std::uint32_t> registry{};
+
+            // builds node for words [begin, end) that share first 'depth' letters, children are built first (bottom up)
+            std::uint32_t build(const std::size_t begin, const std::size_t end, const unsigned int depth) {
+                std::uint32_t letters = 0;
+                std::array<std::uint32_t, 26> node_children{};
+                unsigned int child_count = 0;
+
+                if (depth < words.word_length()) {
+                    for (std::size_t group_begin = begin; group_begin < end;) {
+                        const char letter = words[group_begin][depth];
+                        std::size_t group_end = group_begin + 1;
+                        while (group_end < end && words[group_end][depth] == letter) { group_end++; }
+
+                        letters |= 1u << (letter - 'a');
+                        node_children[child_count++] = build(group_begin, group_end, depth + 1);
+                        group_begin = group_end;
+                    }
+                }
+
+                std::string key(sizeof(letters) + child_count * sizeof(std::uint32_t), '\0');
+                std::memcpy(key.data(), &letters, sizeof(letters));
+                std::memcpy(key.data() + sizeof(letters), node_children.data(), child_count * sizeof(std::uint32_t));
+                if (const auto existing = registry.find(key); existing != registry.end()) { return existing->second; }
+
+                const auto index = static_cast<std::uint32_t>(node_letters.size());
+                node_letters.push_back(letters);
+                node_first_child.push_back(static_cast<std::uint32_t>(children.size()));
+                children.insert(children.end(), node_children.begin(), node_children.begin() + child_count);
+                registry.emplace(std::move(key), index);
+                return index;
+            }
+        };
+    }
+
+    Dawg::Dawg(const WordList words) : length(words.word_length()), word_count(words.size()) {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::DICTIONARY);
+        if (words.empty()) { return; }
+
+        std::vector<std::uint32_t> children;
+        Builder builder{words, children};
+        const std::uint32_t root_index = builder.build(0, words.size(), 0);
+        node_count = builder.node_letters.size();
+
+        // nodes are laid out in order they were built, offset of node is sum of sizes (mask and children) of nodes before it
+        const auto lay_out = [&]<typename Unit>(std::vector<Unit>& graph) {
+            constexpr std::size_t mask_units = sizeof(std::uint32_t) / sizeof(Unit);
+            std::vector<std::uint32_t> offsets(node_count);
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < node_count; ++i) {
+                offsets[i] = static_cast<std::uint32_t>(size);
+                size += mask_units + std::popcount(builder.node_letters[i]);
+            }
+
+            graph.reserve(size);
+            for (std::size_t i = 0; i < node_count; ++i) {
+                for (std::size_t unit = 0; unit < mask_units; ++unit) { graph.push_back(static_cast<Unit>(builder.node_letters[i] >> unit * 16)); }
+                const std::uint32_t first_child = builder.node_first_child[i];
+                for (int c = 0; c < std::popcount(builder.node_letters[i]); ++c) { graph.push_back(static_cast<Unit>(offsets[children[first_child + c]])); }
+            }
+            root = offsets[root_index];
+        };
+        // 16-bit offsets reach only the first 64 Ki entries
+        if (2 * node_count + children.size() <= 0x10000) { lay_out(narrow_graph); }
+        else { lay_out(wide_graph); }
+    }
+
+    bool Dawg::contains(const std::string_view word) const {
+        return word.size() == length && walk(word).has_value();
+    }
+
+    bool Dawg::isPrefix(const std::string_view prefix) const {
+        return prefix.size() <= length && walk(prefix).has_value();
+    }
+
+    Dawg::LetterMask Dawg::nextLetters(const std::string_view prefix) const {
+        const std::optional<std::uint32_t> node = prefix.size() <= length ? walk(prefix) : std::nullopt;
+        return node.has_value() ? letters(node.value()) : 0;
+    }
+
+    // Private:
+    std::uint32_t Dawg::letters(const std::uint32_t node) const {
+        if (!wide_graph.empty()) { return wide_graph[node]; }
+        return narrow_graph[node] | static_cast<std::uint32_t>(narrow_graph[node + 1]) << 16;
+    }
+
+    std::uint32_t Dawg::child(const std::uint32_t node, const unsigned int index) const {
+        if (!wide_graph.empty()) { return wide_graph[node + 1 + index]; }
+        return narrow_graph[node + 2 + index];
+    }
+
+    std::optional<std::uint32_t> Dawg::walk(const std::string_view prefix) const {
+        if (node_count == 0) { return std::nullopt; }
+
+        std::uint32_t node = root;
+        for (const char c : prefix) {
+            if (c < 'a' || c > 'z') { return std::nullopt; }
+            const std::uint32_t bit = 1u << (c - 'a');
+            const std::uint32_t node_letters = letters(node);
+            if ((node_letters & bit) == 0) { return std::nullopt; }
+            // children are ordered by letter, so index of child is number of letters before it
+            node = child(node, std::popcount(node_letters & (bit - 1)));
+        }
+        return node;
+    }
+}
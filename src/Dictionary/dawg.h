@@ -0,0 +1,59 @@
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "word_list.hpp"
+
+namespace Dictionary {
+    /*
+     *  Minimal directed acyclic word graph of a word list (trie where nodes with the same suffixes are merged).
+     *  Whole graph is one array: every node is 26-bit mask of letters that can follow it, directly followed by
+     *  offsets of its children (ordered by letter), and node is identified by its offset. So there is no child index
+     *  to store, and following an edge is just one popcount. Any query costs O(length of the queried text).
+     *  Array is 16-bit (mask takes two entries) when graph is small enough for that, 32-bit otherwise.
+     */
+    class Dawg {
+        // only one of those vectors is used
+        std::vector<std::uint16_t> narrow_graph{};
+        std::vector<std::uint32_t> wide_graph{};
+        std::uint32_t root = 0;
+        unsigned int length = 0;
+        std::size_t word_count = 0;
+        std::size_t node_count = 0;
+
+        [[nodiscard]] std::uint32_t letters(std::uint32_t node) const;
+        // node the edge of given index (number of node's letters before it) leads to
+        [[nodiscard]] std::uint32_t child(std::uint32_t node, unsigned int index) const;
+        // node reached by prefix (nothing if no word starts with it)
+        [[nodiscard]] std::optional<std::uint32_t> walk(std::string_view prefix) const;
+
+        public:
+            // bit for every letter ('a' is bit 0)
+            using LetterMask = std::uint32_t;
+
+            Dawg() = default;
+            // words have to be sorted and lowercase (every WordList is)
+            explicit Dawg(WordList words);
+
+            [[nodiscard]] unsigned int word_length() const { return length; }
+            [[nodiscard]] std::size_t size() const { return word_count; }
+
+            [[nodiscard]] bool contains(std::string_view word) const;
+            // true if at least one word starts with prefix (empty prefix too, if graph isn't empty)
+            [[nodiscard]] bool isPrefix(std::string_view prefix) const;
+            // letters that can follow prefix (0 if prefix is not valid, or it's a whole word)
+            [[nodiscard]] LetterMask nextLetters(std::string_view prefix) const;
+
+            [[nodiscard]] std::size_t nodeCount() const { return node_count; }
+            // bytes taken by the graph
+            [[nodiscard]] std::size_t memoryBytes() const {
+                return narrow_graph.size() * sizeof(std::uint16_t) + wide_graph.size() * sizeof(std::uint32_t);
+            }
+    };
+}
+
+#endif //DAWG_H
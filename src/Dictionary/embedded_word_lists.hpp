@@ -0,0 +1,35 @@
+#ifndef EMBEDDED_WORD_LISTS_H
+#define EMBEDDED_WORD_LISTS_H
+
+#include "word_list.hpp"
+
+/*
+ *  Word lists compiled into the binary. Raw resources are only used in constant expressions,
+ *  so the executable carries just the packed letters (read-only data, no relocations)
+ *  and nothing is parsed, copied or allocated at startup.
+ */
+namespace Dictionary::Embedded {
+    constexpr unsigned int word_length = 5;
+
+    namespace detail {
+        inline constexpr std::string_view english_raw[] = {
+            #include "../resources/English.db"
+        };
+        inline constexpr std::string_view wordle_answers_raw[] = {
+            #include "../resources/wordle-answers.db"
+        };
+
+        inline constexpr std::size_t english_count = Dictionary::detail::normalize<word_length>(english_raw).count;
+        inline constexpr std::size_t wordle_answers_count = Dictionary::detail::normalize<word_length>(wordle_answers_raw).count;
+
+        inline constexpr auto english_letters = Dictionary::detail::pack<word_length, english_count>(english_raw);
+        inline constexpr auto wordle_answers_letters = Dictionary::detail::pack<word_length, wordle_answers_count>(wordle_answers_raw);
+    }
+
+    // 5-letter english dictionary (used for validating guesses)
+    inline constexpr WordList english_5_word_dictionary{std::string_view{detail::english_letters.data(), detail::english_letters.size()}, word_length};
+    // words that can be chosen as the word to guess
+    inline constexpr WordList wordle_answers_list{std::string_view{detail::wordle_answers_letters.data(), detail::wordle_answers_letters.size()}, word_length};
+}
+
+#endif //EMBEDDED_WORD_LISTS_H
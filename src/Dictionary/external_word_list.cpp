@@ -0,0 +1,246 @@
+#include "external_word_list.h"
+#include "../Diagnostics/memory_accounting.h"
+#include "../TerminalUI/cache_directory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace Dictionary {
+    namespace {
+        constexpr char cache_magic[8] = {'W', 'O', 'R', 'D', 'L', 'Y', 'W', 'L'};
+        constexpr std::uint32_t cache_version = 2;
+
+        // binary cache header, sorted words (word_count * word_length bytes) follow right after it
+        struct CacheHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t word_length;
+            std::uint64_t word_count;
+            // words of right length that were left out because of letters other than a-z
+            std::uint64_t skipped_count;
+            // source file fingerprint, cache is stale when any of those changes
+            std::uint64_t source_size;
+            std::int64_t source_modification_time;
+        };
+
+        struct SourceFingerprint {
+            std::uint64_t size;
+            std::int64_t modification_time;
+        };
+
+        SourceFingerprint fingerprint(const std::string &path) {
+            struct stat file_stat{};
+            if (stat(path.c_str(), &file_stat) == -1) { throw std::runtime_error("Can't open word list: " + path); }
+            #ifdef __APPLE__
+                const auto modification = file_stat.st_mtimespec;
+            #else
+                const auto modification = file_stat.st_mtim;
+            #endif
+            return {
+                static_cast<std::uint64_t>(file_stat.st_size),
+                static_cast<std::int64_t>(modification.tv_sec) * 1000000000 + modification.tv_nsec
+            };
+        }
+
+        // cache name is derived from absolute source path, so lists with same file name don't collide
+        std::string cache_file_name(const std::string &source_path, const unsigned int word_length) {
+            char* absolute = realpath(source_path.c_str(), nullptr);
+            const std::string resolved = absolute != nullptr ? absolute : source_path;
+            std::free(absolute);
+
+            // FNV-1a
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (const char c : resolved) { hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL; }
+
+            const auto name_start = resolved.find_last_of('/');
+            const std::string base_name = name_start == std::string::npos ? resolved : resolved.substr(name_start + 1);
+
+            char hash_hex[17];
+            std::snprintf(hash_hex, sizeof(hash_hex), "%016llx", static_cast<unsigned long long>(hash));
+            return base_name + "." + hash_hex + "." + std::to_string(word_length) + ".wlc";
+        }
+
+        bool is_separator(const char c) {
+            return c == ',' || c == '"' || c == ';' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        // letters of UTF-8 token (continuation bytes are not counted), and whether any of them is outside of ASCII
+        std::pair<std::size_t, bool> utf8_letters(const std::string_view token) {
+            std::size_t letters = 0;
+            bool non_ascii = false;
+            for (const char c : token) {
+                const auto byte = static_cast<unsigned char>(c);
+                if ((byte & 0xC0) != 0x80) { letters++; }
+                non_ascii |= byte >= 0x80;
+            }
+            return {letters, non_ascii};
+        }
+
+        struct ParsedSource {
+            std::vector<std::uint64_t> keys;
+            std::size_t skipped_count = 0;
+        };
+
+        /*
+         *  Parse source into sorted, unique word keys. Tokens with other characters than ascii letters are skipped,
+         *  words of right length written with other letters (like "żółw") are counted, so caller can tell about them.
+         */
+        ParsedSource parse_source(const std::string &source_path, const unsigned int word_length) {
+            const MappedFile source(source_path);
+            const auto bytes = source.bytes();
+
+            ParsedSource parsed;
+            auto& keys = parsed.keys;
+            std::size_t position = 0;
+            while (position < bytes.size()) {
+                while (position < bytes.size() && is_separator(bytes[position])) { position++; }
+                const std::size_t token_start = position;
+                while (position < bytes.size() && !is_separator(bytes[position])) { position++; }
+
+                const std::string_view token(bytes.data() + token_start, position - token_start);
+                if (detail::is_playable(token, word_length)) { keys.push_back(detail::encode(token)); }
+                else if (const auto [letters, non_ascii] = utf8_letters(token); non_ascii && letters == word_length) { parsed.skipped_count++; }
+            }
+
+            std::ranges::sort(keys);
+            keys.erase(std::ranges::unique(keys).begin(), keys.end());
+            return parsed;
+        }
+
+        bool write_all(const int fd, const char* data, std::size_t size) {
+            while (size > 0) {
+                const ssize_t written = write(fd, data, size);
+                if (written <= 0) { return false; }
+                data += written;
+                size -= written;
+            }
+            return true;
+        }
+
+        // writes cache to temporary file and renames it, so other processes never map half written cache
+        bool write_cache(const std::string &path, const CacheHeader &header, const std::string &letters) {
+            const std::string temporary_path = path + ".tmp." + std::to_string(getpid());
+            const int fd = open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd == -1) { return false; }
+
+            const bool written = write_all(fd, reinterpret_cast<const char*>(&header), sizeof(header))
+                && write_all(fd, letters.data(), letters.size());
+            close(fd);
+
+            if (!written || rename(temporary_path.c_str(), path.c_str()) == -1) {
+                unlink(temporary_path.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        bool is_valid_cache(const std::span<const char> bytes, const unsigned int word_length, const SourceFingerprint &source) {
+            if (bytes.size() < sizeof(CacheHeader)) { return false; }
+            CacheHeader header{};
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            return std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0
+                && header.version == cache_version
+                && header.word_length == word_length
+                && header.source_size == source.size
+                && header.source_modification_time == source.modification_time
+                && bytes.size() == sizeof(CacheHeader) + header.word_count * word_length;
+        }
+    }
+
+    ExternalWordList::ExternalWordList(const std::string &source_path, const unsigned int word_length) : length(word_length) {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::DICTIONARY);
+        if (word_length < min_word_length || word_length > max_word_length) {
+            throw std::runtime_error("Unsupported word length: " + std::to_string(word_length));
+        }
+        const SourceFingerprint source = fingerprint(source_path);
+
+        // try already converted cache first (only mapping and validation can fail here, unsupported list is reported after it)
+        const std::string directory = TerminalUI::cacheDirectory();
+        if (!directory.empty()) {
+            cache_file_path = directory + "/" + cache_file_name(source_path, word_length);
+            bool cached = false;
+            try {
+                MappedFile existing(cache_file_path);
+                if (is_valid_cache(existing.bytes(), word_length, source)) {
+                    cache = std::move(existing);
+                    letters_offset = sizeof(CacheHeader);
+                    word_count = (cache.bytes().size() - sizeof(CacheHeader)) / word_length;
+                    CacheHeader header{};
+                    std::memcpy(&header, cache.bytes().data(), sizeof(header));
+                    skipped_count = header.skipped_count;
+                    cached = true;
+                }
+            } catch (const std::runtime_error&) {
+                // no cache yet
+            }
+            if (cached) {
+                throw_if_unsupported(source_path);
+                return;
+            }
+        }
+
+        // convert source
+        const auto [keys, skipped] = parse_source(source_path, word_length);
+        skipped_count = skipped;
+        std::string letters(keys.size() * word_length, '\0');
+        for (std::size_t i = 0; i < keys.size(); ++i) { detail::decode(keys[i], word_length, letters.data() + i * word_length); }
+
+        CacheHeader header{};
+        std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+        header.version = cache_version;
+        header.word_length = word_length;
+        header.word_count = keys.size();
+        header.skipped_count = skipped;
+        header.source_size = source.size;
+        header.source_modification_time = source.modification_time;
+
+        if (!cache_file_path.empty() && write_cache(cache_file_path, header, letters)) {
+            bool cached = false;
+            try {
+                cache = MappedFile(cache_file_path);
+                if (is_valid_cache(cache.bytes(), word_length, source)) {
+                    letters_offset = sizeof(CacheHeader);
+                    word_count = keys.size();
+                    cached = true;
+                }
+            } catch (const std::runtime_error&) {
+                // fall through to in memory copy
+            }
+            if (cached) {
+                throw_if_unsupported(source_path);
+                return;
+            }
+        }
+
+        // cache is not available, keep words in memory
+        cache = MappedFile();
+        cache_file_path.clear();
+        in_memory_letters = std::move(letters);
+        letters_offset = 0;
+        word_count = keys.size();
+        throw_if_unsupported(source_path);
+    }
+
+    WordList ExternalWordList::words() const {
+        const std::string_view storage = cache.is_mapped()
+            ? std::string_view(cache.bytes().data(), cache.bytes().size())
+            : std::string_view(in_memory_letters);
+        return WordList(storage.substr(letters_offset, word_count * length), length);
+    }
+
+    // Private:
+    void ExternalWordList::throw_if_unsupported(const std::string &source_path) const {
+        if (word_count == 0 && skipped_count > 0) {
+            throw std::runtime_error("Word list " + source_path + " has " + std::to_string(skipped_count) + " words with letters other than a-z (only a-z is supported)");
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef EXTERNAL_WORD_LIST_H
+#define EXTERNAL_WORD_LIST_H
+
+#include <string>
+
+#include "mapped_file.h"
+#include "word_list.hpp"
+
+namespace Dictionary {
+    /*
+     *  Word list loaded from a text file at runtime (one word per line, or the quoted, comma separated format of embedded lists).
+     *  On first use source is converted into compact binary cache (header + sorted fixed-width lowercase words),
+     *  every next start just maps that cache, so there is no parsing and no copying, no matter how big the list is.
+     *  Cache is rebuilt automatically when source file changes (size or modification time).
+     *  If cache can't be written (read-only home etc.), converted words are kept in memory instead.
+     *
+     *  Words are stored one byte per letter and only a-z fits, words written with other letters are left out
+     *  (and counted, list made only of them is an error rather than an empty game).
+     */
+    class ExternalWordList {
+        MappedFile cache{};
+        std::string in_memory_letters{};
+        std::size_t letters_offset = 0;
+        std::size_t word_count = 0;
+        std::size_t skipped_count = 0;
+        unsigned int length = 0;
+        std::string cache_file_path{};
+
+        void throw_if_unsupported(const std::string &source_path) const;
+
+        public:
+            static constexpr unsigned int min_word_length = 4;
+            static constexpr unsigned int max_word_length = 8;
+
+            // throws std::runtime_error if source can't be read, word_length is not supported or no word is written with a-z
+            ExternalWordList(const std::string &source_path, unsigned int word_length);
+
+            // view is valid as long as this object lives
+            [[nodiscard]] WordList words() const;
+            // words of word_length letters that were left out, because they have letters other than a-z
+            [[nodiscard]] std::size_t skipped_words() const { return skipped_count; }
+            // empty if cache couldn't be written
+            [[nodiscard]] const std::string& cache_path() const { return cache_file_path; }
+    };
+}
+
+#endif //EXTERNAL_WORD_LIST_H
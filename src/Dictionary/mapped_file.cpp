@@ -0,0 +1,57 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Dictionary {
+    MappedFile::MappedFile(const std::string &path) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) { throw std::runtime_error("Can't open file: " + path); }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) == -1) {
+            close(fd);
+            throw std::runtime_error("Can't read file size: " + path);
+        }
+
+        size_ = static_cast<std::size_t>(file_stat.st_size);
+        // mmap of 0 bytes is an error, empty file is just an empty span
+        if (size_ > 0) {
+            void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Can't map file: " + path);
+            }
+            data_ = static_cast<const char*>(mapping);
+        }
+        // mapping stays valid after closing descriptor
+        close(fd);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    // Private:
+    void MappedFile::unmap() {
+        if (data_ != nullptr) { munmap(const_cast<char*>(data_), size_); }
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <span>
+#include <string>
+
+namespace Dictionary {
+    /*
+     *  Read-only memory mapping of a whole file (RAII, move-only).
+     *  Pages are loaded lazily by the kernel and shared between processes mapping the same file,
+     *  so mapping big files is cheap as long as only part of them is touched.
+     */
+    class MappedFile {
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+
+        void unmap();
+
+        public:
+            MappedFile() = default;
+            // throws std::runtime_error if file can't be opened or mapped
+            explicit MappedFile(const std::string &path);
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            [[nodiscard]] std::span<const char> bytes() const { return {data_, size_}; }
+            [[nodiscard]] bool is_mapped() const { return data_ != nullptr; }
+
+            ~MappedFile();
+    };
+}
+
+#endif //MAPPED_FILE_H
@@ -0,0 +1,116 @@
+#ifndef WORD_LIST_H
+#define WORD_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Dictionary {
+    /*
+     *  Non-owning view over a word list stored as one contiguous block of fixed-width, lowercase
+     *  and sorted words (no separators, no terminators). Word 'i' lives at letters[i * word_length].
+     *  Because storage is sorted, lookups are binary searches and views are free to copy around.
+     */
+    class WordList {
+        std::string_view letters{};
+        unsigned int length = 0;
+
+        public:
+            constexpr WordList() = default;
+            constexpr WordList(const std::string_view letters, const unsigned int word_length) : letters(letters), length(word_length) {}
+
+            [[nodiscard]] constexpr unsigned int word_length() const { return length; }
+            [[nodiscard]] constexpr std::size_t size() const { return length == 0 ? 0 : letters.size() / length; }
+            [[nodiscard]] constexpr bool empty() const { return size() == 0; }
+            [[nodiscard]] constexpr std::string_view operator[](const std::size_t index) const { return letters.substr(index * length, length); }
+            // raw storage (for example to hand it over to other structures without copying)
+            [[nodiscard]] constexpr std::span<const char> data() const { return {letters.data(), letters.size()}; }
+
+            [[nodiscard]] constexpr bool contains(const std::string_view word) const {
+                if (word.size() != length) { return false; }
+                // binary search over fixed-width records
+                std::size_t low = 0, high = size();
+                while (low < high) {
+                    const std::size_t middle = low + (high - low) / 2;
+                    const auto current = (*this)[middle];
+                    if (current == word) { return true; }
+                    if (current < word) { low = middle + 1; } else { high = middle; }
+                }
+                return false;
+            }
+    };
+
+    namespace detail {
+        constexpr bool is_ascii_letter(const char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+        constexpr char to_lower(const char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+        // only words with exact length and made of letters are playable (raw lists also contain things like "-able" or "ABC")
+        constexpr bool is_playable(const std::string_view word, const std::size_t length) {
+            return word.size() == length && std::ranges::all_of(word, is_ascii_letter);
+        }
+
+        // words are packed into integer keys (5 bits per letter, first letter most significant), so they sort like strings
+        constexpr std::uint64_t encode(const std::string_view word) {
+            std::uint64_t key = 0;
+            for (const char c : word) { key = key << 5 | static_cast<std::uint64_t>(to_lower(c) - 'a'); }
+            return key;
+        }
+        constexpr void decode(const std::uint64_t key, const std::size_t length, char* out) {
+            for (std::size_t c = 0; c < length; ++c) {
+                out[c] = static_cast<char>('a' + (key >> (length - 1 - c) * 5 & 31));
+            }
+        }
+
+        template <std::size_t N>
+        struct NormalizedWords {
+            std::array<std::uint64_t, N> keys{};
+            std::size_t count = 0;
+        };
+
+        /*
+         *  Lowercase, filter, sort and deduplicate raw list, all of that at compile time.
+         *  Sorting is LSD radix sort (one pass per letter), comparison sorts are way too expensive for constexpr evaluation limits.
+         */
+        template <std::size_t Length, std::size_t N>
+        constexpr NormalizedWords<N> normalize(const std::string_view (&raw)[N]) {
+            static_assert(Length * 5 <= 64, "word is too long to be encoded as sort key");
+            NormalizedWords<N> result;
+            for (const auto word : raw) {
+                if (is_playable(word, Length)) { result.keys[result.count++] = encode(word); }
+            }
+
+            std::array<std::uint64_t, N> scratch{};
+            for (std::size_t letter = 0; letter < Length; ++letter) {
+                const std::size_t shift = letter * 5;
+                std::array<std::size_t, 27> offsets{};
+                for (std::size_t i = 0; i < result.count; ++i) { offsets[(result.keys[i] >> shift & 31) + 1]++; }
+                for (std::size_t b = 1; b < offsets.size(); ++b) { offsets[b] += offsets[b - 1]; }
+                for (std::size_t i = 0; i < result.count; ++i) { scratch[offsets[result.keys[i] >> shift & 31]++] = result.keys[i]; }
+                for (std::size_t i = 0; i < result.count; ++i) { result.keys[i] = scratch[i]; }
+            }
+
+            // drop duplicates (they are next to each other after sorting)
+            std::size_t unique = 0;
+            for (std::size_t i = 0; i < result.count; ++i) {
+                if (unique == 0 || result.keys[unique - 1] != result.keys[i]) { result.keys[unique++] = result.keys[i]; }
+            }
+            result.count = unique;
+            return result;
+        }
+
+        // packs normalized words into one contiguous block, Count has to be known upfront (array size)
+        template <std::size_t Length, std::size_t Count, std::size_t N>
+        constexpr std::array<char, Length * Count> pack(const std::string_view (&raw)[N]) {
+            const auto normalized = normalize<Length>(raw);
+            std::array<char, Length * Count> letters{};
+            for (std::size_t i = 0; i < Count; ++i) {
+                decode(normalized.keys[i], Length, letters.data() + i * Length);
+            }
+            return letters;
+        }
+    }
+}
+
+#endif //WORD_LIST_H
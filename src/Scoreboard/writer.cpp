@@ -0,0 +1,168 @@
+#include "writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Scoreboard {
+    namespace {
+        // delay before retrying failed write (doubled after every failure, up to the maximum)
+        constexpr auto first_retry_delay = std::chrono::seconds(1);
+        constexpr auto max_retry_delay = std::chrono::seconds(30);
+
+        std::string error_message(const std::string& action, const std::string& path) {
+            return action + " " + path + ": " + std::strerror(errno);
+        }
+
+        // 'written' is set to how many bytes made it into the file (also when write fails in the middle)
+        bool write_all(const int fd, std::string_view bytes, std::size_t& written) {
+            written = 0;
+            while (written < bytes.size()) {
+                const ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+                if (result < 0 && errno == EINTR) { continue; }
+                if (result <= 0) { return false; }
+                written += result;
+            }
+            return true;
+        }
+    }
+
+    Writer::Writer(std::string path, const SyncPolicy sync_policy, const std::chrono::milliseconds batch_delay) :
+        path(std::move(path)), sync_policy(sync_policy), batch_delay(batch_delay), thread(&Writer::work, this) {}
+
+    std::optional<SyncPolicy> Writer::parseSyncPolicy(const std::string_view name) {
+        if (name == "none") { return SyncPolicy::NONE; }
+        if (name == "batch") { return SyncPolicy::BATCH; }
+        if (name == "record") { return SyncPolicy::RECORD; }
+        return std::nullopt;
+    }
+
+    void Writer::append(std::string record) {
+        {
+            std::lock_guard lock(mutex);
+            queued.push_back(std::move(record));
+        }
+        wake.notify_one();
+    }
+
+    std::vector<std::string> Writer::unwritten() const {
+        std::lock_guard lock(mutex);
+        std::vector<std::string> records = in_flight;
+        records.insert(records.end(), queued.begin(), queued.end());
+        return records;
+    }
+
+    std::optional<std::string> Writer::lastError() const {
+        std::lock_guard lock(mutex);
+        return last_error;
+    }
+
+    std::size_t Writer::close() {
+        {
+            std::lock_guard lock(mutex);
+            if (closed) { return queued.size(); }
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+
+        std::lock_guard lock(mutex);
+        closed = true;
+        return queued.size();
+    }
+
+    Writer::~Writer() {
+        close();
+    }
+
+    // Private:
+    void Writer::work() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return stopping || !queued.empty(); });
+            if (queued.empty()) { return; }
+
+            // records coming right after each other (or during retry delay) go to the same batch
+            if (!stopping) {
+                std::chrono::milliseconds delay = batch_delay;
+                if (failures > 0) { delay = std::min<std::chrono::milliseconds>(first_retry_delay * (1 << std::min(failures - 1, 5u)), max_retry_delay); }
+                wake.wait_for(lock, delay, [this] { return stopping; });
+            }
+            in_flight = std::move(queued);
+            queued.clear();
+            lock.unlock();
+
+            // batch is only read here (and by unwritten() under lock), so it's appended without holding the lock
+            std::size_t written = 0;
+            std::optional<std::string> error = appendBatch(written);
+            lock.lock();
+            // rest of batch goes back before records queued in the meantime (order of records is kept)
+            queued.insert(queued.begin(), std::make_move_iterator(in_flight.begin() + written), std::make_move_iterator(in_flight.end()));
+            in_flight.clear();
+
+            if (error.has_value()) {
+                last_error = std::move(error);
+                failures++;
+                // last attempt on exit failed, records stay in queue (close() reports them)
+                if (stopping) { return; }
+            } else {
+                last_error.reset();
+                failures = 0;
+            }
+        }
+    }
+
+    std::optional<std::string> Writer::appendBatch(std::size_t& written) const {
+        written = 0;
+        // readable too, last byte is checked for torn line
+        const int fd = open(path.c_str(), O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        if (fd == -1) { return error_message("Can't open", path); }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) == -1) {
+            std::string error = error_message("Can't read size of", path);
+            ::close(fd);
+            return error;
+        }
+        const off_t size = file_stat.st_size;
+
+        // line torn by crash (or power failure) is ended, so first record doesn't stick to it
+        std::string text;
+        char last_byte = '\n';
+        if (size > 0 && pread(fd, &last_byte, 1, size - 1) == 1 && last_byte != '\n') { text += '\n'; }
+
+        std::optional<std::string> error;
+        // records of 'text' (first of them is in_flight[written]) start after ending of torn line
+        std::size_t records_offset = text.size();
+        for (std::size_t i = 0; i < in_flight.size() && !error.has_value(); ++i) {
+            text += in_flight[i];
+            text += '\n';
+            // with per-record sync every record is written (and synced) on its own
+            if (sync_policy != SyncPolicy::RECORD && i + 1 < in_flight.size()) { continue; }
+
+            std::size_t written_bytes = 0;
+            if (!write_all(fd, text, written_bytes)) {
+                error = error_message("Can't write", path);
+                /*
+                 *  Whole lines that made it into the file aren't written again, rest of the batch is retried.
+                 *  Written part of the next line is left as it is (other processes may have appended after it,
+                 *  so file isn't truncated), next append ends that torn line and readers skip it.
+                 */
+                const std::string_view written_text = std::string_view(text).substr(0, written_bytes).substr(std::min(records_offset, written_bytes));
+                written += std::ranges::count(written_text, '\n');
+                break;
+            }
+            written = i + 1;
+            records_offset = 0;
+            text.clear();
+            // records are already in file, failed sync is reported, but they aren't written again
+            if (sync_policy != SyncPolicy::NONE && fsync(fd) == -1) { error = error_message("Can't sync", path); }
+        }
+        // errors of delayed writes (NFS) are reported by close
+        if (::close(fd) == -1 && !error.has_value()) { error = error_message("Can't close", path); }
+        return error;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef SCOREBOARD_WRITER_H
+#define SCOREBOARD_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Scoreboard {
+    // when appended records are forced to disk (fsync)
+    enum class SyncPolicy {
+        NONE,    // kernel decides (fastest, last records can be lost on power failure)
+        BATCH,   // once after every batch of records
+        RECORD   // after every record (every record is written separately)
+    };
+
+    /*
+     *  Appends records (lines) to scoreboard file on its own thread, so game never waits for disk (or NFS).
+     *  Records queued within short delay are appended together, with one write() of whole lines to file opened with O_APPEND.
+     *  Line torn by crash (or by write that failed in the middle) is ended before next append, so file never has
+     *  two records glued into one line. File is never truncated, other processes may append to it at the same time.
+     *  Records that couldn't be written stay queued and are retried, last error can be shown to the player.
+     *  Queue is written out when writer is closed (or destroyed).
+     */
+    class Writer {
+        std::string path;
+        SyncPolicy sync_policy;
+        std::chrono::milliseconds batch_delay;
+
+        // queue and state, shared with writer thread
+        mutable std::mutex mutex{};
+        std::condition_variable wake{};
+        std::vector<std::string> queued{};
+        // batch being written (it's still "unwritten" for readers of the file, it can be in file already)
+        std::vector<std::string> in_flight{};
+        std::optional<std::string> last_error{};
+        unsigned int failures = 0;
+        bool stopping = false;
+        bool closed = false;
+
+        std::thread thread;
+
+        void work();
+        /*
+         *  Appends in-flight batch (no lock is held, readers never wait for disk), returns error message if it failed,
+         *  'written' is set to how many records made it into the file (they aren't retried).
+         */
+        [[nodiscard]] std::optional<std::string> appendBatch(std::size_t& written) const;
+
+        public:
+            explicit Writer(std::string path, SyncPolicy sync_policy = SyncPolicy::BATCH,
+                            std::chrono::milliseconds batch_delay = std::chrono::milliseconds(100));
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            // "none", "batch" or "record" (nothing for anything else)
+            static std::optional<SyncPolicy> parseSyncPolicy(std::string_view name);
+
+            [[nodiscard]] const std::string& filePath() const { return path; }
+            // queues record (line without newline), never blocks on disk
+            void append(std::string record);
+
+            /*
+             *  Reading whole scoreboard: take unwritten() records first, then read the file, and drop unwritten records
+             *  that are in the file already (batch may have been written in the meantime), every record is then seen once.
+             */
+            [[nodiscard]] std::vector<std::string> unwritten() const;
+            // last write error (reset by successful write)
+            [[nodiscard]] std::optional<std::string> lastError() const;
+
+            // writes out queue (one more attempt if writing fails), stops the thread, returns number of records that couldn't be written
+            std::size_t close();
+
+            ~Writer();
+    };
+}
+
+#endif //SCOREBOARD_WRITER_H
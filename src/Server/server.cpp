@@ -0,0 +1,341 @@
+#include "server.h"
+#include "../Diagnostics/memory_accounting.h"
+
+#include <cerrno>
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+    #include <sys/epoll.h>
+#else
+    #include <poll.h>
+#endif
+
+
+namespace Server {
+    namespace {
+        // how long server waits for window size before session is started with default size
+        constexpr auto window_size_timeout = std::chrono::milliseconds(250);
+        constexpr TerminalUI::Dimension default_dimensions{24, 80};
+        // client that doesn't read its output is disconnected, instead of buffering frames forever
+        constexpr std::size_t max_pending_output = 1 << 20;
+        // input received before session started (it's passed to session when it starts)
+        constexpr std::size_t max_pending_input = 4096;
+    }
+
+    Server::Connection::Connection(const int file_descriptor, const std::uint64_t id) : file_descriptor(file_descriptor), id(id) {}
+
+    void Server::Connection::write(const std::string_view bytes) { output.append(bytes); }
+
+    // waits for readiness of many descriptors at once (level triggered)
+    class Server::Poller {
+        public:
+            struct Event {
+                int file_descriptor;
+                bool readable;
+                bool writable;
+            };
+
+        private:
+            std::vector<Event> ready{};
+            #ifdef __linux__
+                int epoll_descriptor;
+                std::vector<epoll_event> epoll_events = std::vector<epoll_event>(256);
+
+                void control(const int operation, const int file_descriptor, const bool write_interest) const {
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP | (write_interest ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+                    event.data.fd = file_descriptor;
+                    epoll_ctl(epoll_descriptor, operation, file_descriptor, &event);
+                }
+            #else
+                std::vector<pollfd> descriptors{};
+                // position of descriptor in 'descriptors'
+                std::unordered_map<int, std::size_t> indices{};
+            #endif
+
+        public:
+            Poller() {
+                #ifdef __linux__
+                    epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+                    if (epoll_descriptor < 0) { throw std::runtime_error("Can't create epoll instance"); }
+                #endif
+            }
+
+            void add(const int file_descriptor) {
+                #ifdef __linux__
+                    control(EPOLL_CTL_ADD, file_descriptor, false);
+                #else
+                    indices[file_descriptor] = descriptors.size();
+                    descriptors.push_back(pollfd{file_descriptor, POLLIN, 0});
+                #endif
+            }
+            void setWriteInterest(const int file_descriptor, const bool enabled) {
+                #ifdef __linux__
+                    control(EPOLL_CTL_MOD, file_descriptor, enabled);
+                #else
+                    descriptors[indices.at(file_descriptor)].events = POLLIN | (enabled ? POLLOUT : 0);
+                #endif
+            }
+            void remove(const int file_descriptor) {
+                #ifdef __linux__
+                    epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, file_descriptor, nullptr);
+                #else
+                    // last descriptor takes place of removed one
+                    const std::size_t index = indices.at(file_descriptor);
+                    descriptors[index] = descriptors.back();
+                    indices[descriptors[index].fd] = index;
+                    descriptors.pop_back();
+                    indices.erase(file_descriptor);
+                #endif
+            }
+
+            // timeout in milliseconds (-1 waits until some descriptor is ready)
+            const std::vector<Event>& wait(const int timeout) {
+                ready.clear();
+                #ifdef __linux__
+                    const int count = epoll_wait(epoll_descriptor, epoll_events.data(), static_cast<int>(epoll_events.size()), timeout);
+                    for (int i = 0; i < count; ++i) {
+                        const std::uint32_t events = epoll_events[i].events;
+                        // errors and hang ups are reported as readable, reading them closes connection
+                        ready.push_back(Event{epoll_events[i].data.fd, (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0, (events & EPOLLOUT) != 0});
+                    }
+                #else
+                    const int count = ::poll(descriptors.data(), descriptors.size(), timeout);
+                    for (std::size_t i = 0; count > 0 && i < descriptors.size(); ++i) {
+                        const short events = descriptors[i].revents;
+                        if (events == 0) { continue; }
+                        ready.push_back(Event{descriptors[i].fd, (events & (POLLIN | POLLHUP | POLLERR)) != 0, (events & POLLOUT) != 0});
+                    }
+                #endif
+                return ready;
+            }
+
+            ~Poller() {
+                #ifdef __linux__
+                    close(epoll_descriptor);
+                #endif
+            }
+    };
+
+    Server::Server(Address address_, SessionFactory session_factory_) :
+        address(std::move(address_)), session_factory(std::move(session_factory_)), listen_descriptor(listenOn(address)), poller(std::make_unique<Poller>()) {
+        // writing to disconnected client must not kill whole server
+        std::signal(SIGPIPE, SIG_IGN);
+        poller->add(listen_descriptor);
+    }
+
+    void Server::run() {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SERVER);
+        while (!stop_requested) {
+            // sleep until some connection has input, or the nearest session deadline
+            int timeout = -1;
+            if (!deadlines.empty()) {
+                const auto remaining = deadlines.top().time - TerminalUI::Clock::now();
+                // rounded up, so loop doesn't wake up just before deadline
+                timeout = static_cast<int>(std::max<std::int64_t>(std::chrono::ceil<std::chrono::milliseconds>(remaining).count(), 0));
+            }
+
+            for (const Poller::Event& event : poller->wait(timeout)) {
+                if (event.file_descriptor == listen_descriptor) {
+                    acceptConnections();
+                    continue;
+                }
+                const auto connection = connections.find(event.file_descriptor);
+                if (connection == connections.end()) { continue; }
+
+                if (event.writable) {
+                    if (!flush(*connection->second)) { continue; }
+                    // frame held back while socket was full is drawn as soon as it's empty (receiving input steps session anyway)
+                    if (!event.readable && connection->second->output.empty() && connection->second->session) {
+                        step(*connection->second, TerminalUI::Clock::now());
+                        continue;
+                    }
+                }
+                if (event.readable) { receive(*connection->second); }
+            }
+
+            runDueDeadlines(TerminalUI::Clock::now());
+        }
+    }
+
+    Server::~Server() {
+        while (!connections.empty()) {
+            Connection& connection = *connections.begin()->second;
+            // session restores client terminal (cursor) when it's destroyed, so it's written before closing
+            connection.session.reset();
+            connection.closing = true;
+            if (flush(connection)) { closeConnection(connection.file_descriptor); }
+        }
+        close(listen_descriptor);
+        if (!address.isTcp()) { unlink(address.unix_path.c_str()); }
+    }
+
+    // Private:
+    void Server::acceptConnections() {
+        while (true) {
+            const int file_descriptor = accept(listen_descriptor, nullptr, nullptr);
+            if (file_descriptor < 0) {
+                if (errno == EINTR) { continue; }
+                // no more waiting connections (or out of descriptors, then they wait in backlog)
+                return;
+            }
+            setNonBlocking(file_descriptor);
+            if (address.isTcp()) {
+                // frames are written at once, there is no reason to wait for more data
+                const int no_delay = 1;
+                setsockopt(file_descriptor, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+            }
+            poller->add(file_descriptor);
+
+            auto connection = std::make_unique<Connection>(file_descriptor, next_connection_id++);
+            Connection& added = *connection;
+            connections[file_descriptor] = std::move(connection);
+
+            added.write(std::string_view(reinterpret_cast<const char*>(Telnet::negotiation), sizeof(Telnet::negotiation)));
+            // session starts when window size arrives, or when this deadline passes
+            schedule(added, TerminalUI::Clock::now() + window_size_timeout);
+            flush(added);
+        }
+    }
+
+    void Server::receive(Connection& connection) {
+        char buffer[4096];
+        std::string data;
+        while (true) {
+            const ssize_t length = read(connection.file_descriptor, buffer, sizeof(buffer));
+            if (length > 0) {
+                if (const auto window_size = connection.telnet.decode(std::string_view(buffer, length), data)) {
+                    connection.window_size = window_size;
+                    if (connection.session) { connection.session->resize(TerminalUI::Dimension{window_size->height, window_size->width}); }
+                }
+                continue;
+            }
+            if (length < 0 && errno == EINTR) { continue; }
+            if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+            // client disconnected (or connection failed)
+            closeConnection(connection.file_descriptor);
+            return;
+        }
+
+        if (!connection.session) {
+            connection.pending_input.append(data, 0, max_pending_input - std::min(connection.pending_input.size(), max_pending_input));
+            if (connection.window_size.has_value()) { startSession(connection); }
+            return;
+        }
+        try {
+            if (!data.empty()) { connection.session->input(data); }
+        } catch (const std::exception& error) {
+            dropSession(connection, error);
+            return;
+        }
+        step(connection, TerminalUI::Clock::now());
+    }
+
+    void Server::startSession(Connection& connection) {
+        const TerminalUI::Dimension dimensions = connection.window_size.has_value()
+            ? TerminalUI::Dimension{connection.window_size->height, connection.window_size->width}
+            : default_dimensions;
+        try {
+            connection.session = session_factory(connection, dimensions);
+            if (!connection.pending_input.empty()) { connection.session->input(connection.pending_input); }
+        } catch (const std::exception& error) {
+            dropSession(connection, error);
+            return;
+        }
+        connection.pending_input.clear();
+        connection.pending_input.shrink_to_fit();
+        step(connection, TerminalUI::Clock::now());
+    }
+
+    void Server::step(Connection& connection, const TerminalUI::Clock::time_point now) {
+        try {
+            schedule(connection, connection.session->tick(now));
+        } catch (const std::exception& error) {
+            dropSession(connection, error);
+            return;
+        }
+        if (connection.session->finished()) {
+            connection.session.reset();
+            connection.closing = true;
+        }
+        flush(connection);
+    }
+
+    void Server::schedule(Connection& connection, const std::optional<TerminalUI::Clock::time_point> deadline) {
+        connection.deadline = deadline;
+        if (deadline.has_value()) { deadlines.push(Deadline{deadline.value(), connection.file_descriptor, connection.id}); }
+    }
+
+    void Server::runDueDeadlines(const TerminalUI::Clock::time_point now) {
+        while (!deadlines.empty() && deadlines.top().time <= now) {
+            const Deadline due = deadlines.top();
+            deadlines.pop();
+
+            // connection could be closed (and descriptor reused), or session could have rescheduled since then
+            const auto found = connections.find(due.file_descriptor);
+            if (found == connections.end() || found->second->id != due.connection_id || found->second->deadline != due.time) { continue; }
+
+            Connection& connection = *found->second;
+            connection.deadline.reset();
+            if (!connection.session) { startSession(connection); }
+            else { step(connection, now); }
+        }
+    }
+
+    bool Server::flush(Connection& connection) {
+        std::size_t written = 0;
+        while (written < connection.output.size()) {
+            const ssize_t length = write(connection.file_descriptor, connection.output.data() + written, connection.output.size() - written);
+            if (length > 0) {
+                written += length;
+                continue;
+            }
+            if (length < 0 && errno == EINTR) { continue; }
+            if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+            closeConnection(connection.file_descriptor);
+            return false;
+        }
+        connection.output.erase(0, written);
+
+        // rest is written when socket becomes writable again
+        if (!connection.output.empty()) {
+            if (connection.output.size() > max_pending_output) {
+                closeConnection(connection.file_descriptor);
+                return false;
+            }
+            if (!connection.write_interest) {
+                poller->setWriteInterest(connection.file_descriptor, true);
+                connection.write_interest = true;
+            }
+            return true;
+        }
+
+        if (connection.write_interest) {
+            poller->setWriteInterest(connection.file_descriptor, false);
+            connection.write_interest = false;
+        }
+        if (connection.closing) {
+            closeConnection(connection.file_descriptor);
+            return false;
+        }
+        return true;
+    }
+
+    void Server::dropSession(Connection& connection, const std::exception& error) {
+        // failure of one session (for example too small window) ends only its connection
+        std::cerr << "Session " << connection.id << " failed: " << error.what() << std::endl;
+        closeConnection(connection.file_descriptor);
+    }
+
+    void Server::closeConnection(const int file_descriptor) {
+        poller->remove(file_descriptor);
+        close(file_descriptor);
+        connections.erase(file_descriptor);
+    }
+}
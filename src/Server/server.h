@@ -0,0 +1,116 @@
+#ifndef SERVER_H
+#define SERVER_H
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "socket.h"
+#include "telnet.h"
+#include "../TerminalUI/output_sink.h"
+#include "../TerminalUI/terminal.h"
+#include "../TerminalUI/timeline.h"
+
+namespace Server {
+    // app running in one connection (usually app with its own renderer bound to connection output)
+    class Session {
+        public:
+            // input bytes from client (telnet commands are already removed)
+            virtual void input(std::string_view bytes) = 0;
+            virtual void resize(TerminalUI::Dimension dimensions) = 0;
+            // renders frame if needed, returns when session needs next step (nothing if it just waits for input)
+            virtual std::optional<TerminalUI::Clock::time_point> tick(TerminalUI::Clock::time_point now) = 0;
+            // connection is closed when session is finished (for example user quit the app)
+            [[nodiscard]] virtual bool finished() const = 0;
+
+            virtual ~Session() = default;
+    };
+    // creates session for new connection, output of session goes to 'output' (it lives as long as session)
+    using SessionFactory = std::function<std::unique_ptr<Session>(TerminalUI::OutputSink& output, TerminalUI::Dimension dimensions)>;
+
+    /*
+     *  Runs many telnet-style sessions in one thread: one event loop (epoll on Linux, poll elsewhere) waits for input of all
+     *  connections and for the nearest session deadline (animations), so idle sessions cost only their memory.
+     *  Session is started when client reports its window size (or after short timeout with 80x24).
+     */
+    class Server {
+        class Poller;
+
+        // connection is the output sink of its session, frames are buffered until socket takes them
+        struct Connection final : TerminalUI::OutputSink {
+            int file_descriptor;
+            std::uint64_t id;
+            TelnetDecoder telnet{};
+            std::optional<WindowSize> window_size{};
+
+            std::string output{};
+            bool write_interest = false;
+            // connection is closed once its output is written
+            bool closing = false;
+
+            std::string pending_input{};
+            // declared after output, session can still write while it's destroyed
+            std::unique_ptr<Session> session{};
+            std::optional<TerminalUI::Clock::time_point> deadline{};
+
+            Connection(int file_descriptor, std::uint64_t id);
+
+            void write(std::string_view bytes) override;
+            // frames are held back by session's renderer while socket didn't take previous ones
+            [[nodiscard]] std::size_t pendingBytes() const override { return output.size() + TerminalUI::kernelOutputQueue(file_descriptor); }
+        };
+
+        struct Deadline {
+            TerminalUI::Clock::time_point time;
+            int file_descriptor;
+            std::uint64_t connection_id;
+
+            bool operator>(const Deadline& other) const { return time > other.time; }
+        };
+
+        Address address;
+        SessionFactory session_factory;
+        int listen_descriptor;
+        std::unique_ptr<Poller> poller;
+
+        std::unordered_map<int, std::unique_ptr<Connection>> connections{};
+        std::uint64_t next_connection_id = 1;
+        // deadlines of sessions, entries are checked against connection when they are due (outdated ones are skipped)
+        std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> deadlines{};
+
+        std::atomic<bool> stop_requested{false};
+
+        void acceptConnections();
+        void receive(Connection& connection);
+        void startSession(Connection& connection);
+        void step(Connection& connection, TerminalUI::Clock::time_point now);
+        void schedule(Connection& connection, std::optional<TerminalUI::Clock::time_point> deadline);
+        void runDueDeadlines(TerminalUI::Clock::time_point now);
+        // writes as much pending output as socket takes, returns false if connection was closed
+        bool flush(Connection& connection);
+        void dropSession(Connection& connection, const std::exception& error);
+        void closeConnection(int file_descriptor);
+
+        public:
+            Server(Address address, SessionFactory session_factory);
+
+            // event loop, runs until stop() is called
+            void run();
+            // safe to call from signal handler
+            void stop() { stop_requested = true; }
+
+            [[nodiscard]] std::size_t sessionCount() const { return connections.size(); }
+            [[nodiscard]] const Address& listenAddress() const { return address; }
+
+            ~Server();
+    };
+}
+
+#endif //SERVER_H
@@ -0,0 +1,112 @@
+#include "socket.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Server {
+    namespace {
+        constexpr int listen_backlog = 1024;
+
+        [[noreturn]] void throwError(const std::string& message) {
+            throw std::runtime_error(message + ": " + std::strerror(errno));
+        }
+
+        sockaddr_un unixAddress(const std::string& path) {
+            sockaddr_un address{};
+            if (path.size() >= sizeof(address.sun_path)) { throw std::runtime_error("Unix socket path is too long: " + path); }
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return address;
+        }
+
+        sockaddr_in localhostAddress(const std::uint16_t port) {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            return address;
+        }
+    }
+
+    std::string Address::toString() const {
+        return isTcp() ? "127.0.0.1:" + std::to_string(tcp_port) : unix_path;
+    }
+
+    Address Address::parse(const std::string_view text) {
+        if (text.empty()) { throw std::runtime_error("Empty server address"); }
+
+        Address address;
+        if (std::ranges::all_of(text, [](const char c) { return c >= '0' && c <= '9'; })) {
+            const unsigned long port = text.size() <= 5 ? std::stoul(std::string(text)) : 0;
+            if (port == 0 || port > 65535) { throw std::runtime_error("Invalid TCP port: " + std::string(text)); }
+            address.tcp_port = static_cast<std::uint16_t>(port);
+        }
+        else { address.unix_path = std::string(text); }
+        return address;
+    }
+
+    int listenOn(const Address& address) {
+        const int file_descriptor = socket(address.isTcp() ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+        if (file_descriptor < 0) { throwError("Can't create socket"); }
+
+        int result;
+        if (address.isTcp()) {
+            const int reuse = 1;
+            setsockopt(file_descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            const sockaddr_in tcp_address = localhostAddress(address.tcp_port);
+            result = bind(file_descriptor, reinterpret_cast<const sockaddr*>(&tcp_address), sizeof(tcp_address));
+        }
+        else {
+            // socket file is not removed when server is killed, only sockets are replaced (never regular files)
+            struct stat status{};
+            if (stat(address.unix_path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) { unlink(address.unix_path.c_str()); }
+            const sockaddr_un unix_address = unixAddress(address.unix_path);
+            result = bind(file_descriptor, reinterpret_cast<const sockaddr*>(&unix_address), sizeof(unix_address));
+        }
+        if (result < 0 || listen(file_descriptor, listen_backlog) < 0) {
+            const int error = errno;
+            close(file_descriptor);
+            errno = error;
+            throwError("Can't listen on " + address.toString());
+        }
+
+        setNonBlocking(file_descriptor);
+        return file_descriptor;
+    }
+
+    int connectTo(const Address& address) {
+        const int file_descriptor = socket(address.isTcp() ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+        if (file_descriptor < 0) { throwError("Can't create socket"); }
+
+        int result;
+        if (address.isTcp()) {
+            const sockaddr_in tcp_address = localhostAddress(address.tcp_port);
+            result = connect(file_descriptor, reinterpret_cast<const sockaddr*>(&tcp_address), sizeof(tcp_address));
+        }
+        else {
+            const sockaddr_un unix_address = unixAddress(address.unix_path);
+            result = connect(file_descriptor, reinterpret_cast<const sockaddr*>(&unix_address), sizeof(unix_address));
+        }
+        if (result < 0) {
+            const int error = errno;
+            close(file_descriptor);
+            errno = error;
+            throwError("Can't connect to " + address.toString());
+        }
+        return file_descriptor;
+    }
+
+    void setNonBlocking(const int file_descriptor) {
+        const int flags = fcntl(file_descriptor, F_GETFL, 0);
+        if (flags < 0 || fcntl(file_descriptor, F_SETFL, flags | O_NONBLOCK) < 0) { throwError("Can't set socket non-blocking"); }
+    }
+}
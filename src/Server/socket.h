@@ -0,0 +1,27 @@
+#ifndef SERVER_SOCKET_H
+#define SERVER_SOCKET_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Server {
+    // where server listens (and where clients connect to): path of Unix socket, or TCP port on localhost
+    struct Address {
+        std::string unix_path{};
+        std::uint16_t tcp_port = 0;
+
+        [[nodiscard]] bool isTcp() const { return unix_path.empty(); }
+        [[nodiscard]] std::string toString() const;
+
+        // port number (for example "2323") means localhost TCP, anything else is path of Unix socket
+        static Address parse(std::string_view text);
+    };
+
+    // non-blocking listening socket (stale Unix socket file left by previous server is replaced)
+    int listenOn(const Address& address);
+    // blocking connection to server
+    int connectTo(const Address& address);
+    void setNonBlocking(int file_descriptor);
+}
+
+#endif //SERVER_SOCKET_H
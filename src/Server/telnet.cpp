@@ -0,0 +1,74 @@
+#include "telnet.h"
+
+#include <algorithm>
+
+namespace Server {
+    namespace {
+        // window size reported by client is clamped, so one session can't allocate huge screen
+        constexpr unsigned int max_window_width = 400;
+        constexpr unsigned int max_window_height = 200;
+        // subnegotiation longer than this is not NAWS, rest of it is ignored
+        constexpr std::size_t max_subnegotiation_length = 32;
+    }
+
+    std::optional<WindowSize> TelnetDecoder::decode(const std::string_view received, std::string& data) {
+        std::optional<WindowSize> window_size;
+
+        for (const char c : received) {
+            const auto byte = static_cast<unsigned char>(c);
+            switch (state) {
+                case State::CARRIAGE_RETURN:
+                    state = State::DATA;
+                    // CR LF and CR NUL are just enter (already added)
+                    if (byte == '\n' || byte == '\0') { break; }
+                    [[fallthrough]];
+                case State::DATA:
+                    if (byte == Telnet::IAC) { state = State::COMMAND; }
+                    else if (byte == '\r') { data += '\n'; state = State::CARRIAGE_RETURN; }
+                    else { data += c; }
+                    break;
+                case State::COMMAND:
+                    if (byte == Telnet::IAC) { data += c; state = State::DATA; }
+                    else if (byte == Telnet::SB) { subnegotiation.clear(); state = State::SUBNEGOTIATION; }
+                    else if (byte >= Telnet::WILL) { state = State::OPTION; }
+                    // other commands (NOP, AYT, ...) don't have arguments
+                    else { state = State::DATA; }
+                    break;
+                case State::OPTION:
+                    // answers to negotiation are accepted silently
+                    state = State::DATA;
+                    break;
+                case State::SUBNEGOTIATION:
+                    if (byte == Telnet::IAC) { state = State::SUBNEGOTIATION_COMMAND; }
+                    else if (subnegotiation.size() < max_subnegotiation_length) { subnegotiation += c; }
+                    break;
+                case State::SUBNEGOTIATION_COMMAND:
+                    if (byte == Telnet::SE) {
+                        if (const auto reported = finishSubnegotiation()) { window_size = reported; }
+                        state = State::DATA;
+                    }
+                    else {
+                        // escaped IAC inside subnegotiation
+                        if (subnegotiation.size() < max_subnegotiation_length) { subnegotiation += c; }
+                        state = State::SUBNEGOTIATION;
+                    }
+                    break;
+            }
+        }
+        return window_size;
+    }
+
+    // Private:
+    std::optional<WindowSize> TelnetDecoder::finishSubnegotiation() const {
+        // NAWS: option, width (2 bytes, big endian), height (2 bytes)
+        if (subnegotiation.size() != 5 || static_cast<unsigned char>(subnegotiation[0]) != Telnet::OPTION_NAWS) { return std::nullopt; }
+
+        const auto byte = [this](const std::size_t i) { return static_cast<unsigned int>(static_cast<unsigned char>(subnegotiation[i])); };
+        const unsigned int width = byte(1) << 8 | byte(2);
+        const unsigned int height = byte(3) << 8 | byte(4);
+        // some clients report 0 when they don't know
+        if (width == 0 || height == 0) { return std::nullopt; }
+
+        return WindowSize{std::min(width, max_window_width), std::min(height, max_window_height)};
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef SERVER_TELNET_H
+#define SERVER_TELNET_H
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Server {
+    namespace Telnet {
+        inline constexpr unsigned char IAC = 255;
+        inline constexpr unsigned char DONT = 254;
+        inline constexpr unsigned char DO = 253;
+        inline constexpr unsigned char WONT = 252;
+        inline constexpr unsigned char WILL = 251;
+        inline constexpr unsigned char SB = 250;
+        inline constexpr unsigned char SE = 240;
+
+        inline constexpr unsigned char OPTION_ECHO = 1;
+        inline constexpr unsigned char OPTION_SUPPRESS_GO_AHEAD = 3;
+        inline constexpr unsigned char OPTION_NAWS = 31;
+
+        // sent to every new client: server echoes (so client doesn't), character mode, and client should report its window size
+        inline constexpr unsigned char negotiation[] = {
+            IAC, WILL, OPTION_ECHO,
+            IAC, WILL, OPTION_SUPPRESS_GO_AHEAD,
+            IAC, DO, OPTION_NAWS
+        };
+    }
+
+    struct WindowSize {
+        unsigned int width = 0;
+        unsigned int height = 0;
+    };
+
+    /*
+     *  Removes telnet commands from bytes received from client (state is kept between reads, so commands can be split).
+     *  Only window size (NAWS) is understood, other options are ignored. Enter (CR LF or CR NUL) becomes '\n',
+     *  the same as in local terminal.
+     */
+    class TelnetDecoder {
+        enum class State {
+            DATA,
+            CARRIAGE_RETURN,
+            COMMAND,
+            OPTION,
+            SUBNEGOTIATION,
+            SUBNEGOTIATION_COMMAND
+        };
+        State state = State::DATA;
+        std::string subnegotiation{};
+
+        [[nodiscard]] std::optional<WindowSize> finishSubnegotiation() const;
+
+        public:
+            // appends data bytes to 'data', returns window size if client reported it in these bytes (last report wins)
+            std::optional<WindowSize> decode(std::string_view received, std::string& data);
+    };
+}
+
+#endif //SERVER_TELNET_H
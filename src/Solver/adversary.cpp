@@ -0,0 +1,114 @@
+#include "adversary.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "partition.hpp"
+
+namespace Solver {
+    namespace {
+        // scored pairs (guess and candidate) one thread does for look-ahead, well under a frame
+        constexpr std::size_t lookahead_budget = 250'000;
+        // next guesses are split into this many tasks per thread (threads that finish early take more)
+        constexpr std::size_t tasks_per_thread = 4;
+
+        // size of the largest group 'guess' splits candidates into ('bucket_sizes' is scratch of pattern_count() entries)
+        std::uint32_t largest_group(const std::string_view guess, const Dictionary::WordList answers, const std::span<const std::uint32_t> candidates,
+                                    std::vector<std::uint32_t>& bucket_sizes) {
+            std::ranges::fill(bucket_sizes, 0);
+            std::uint32_t largest = 0;
+            for (const std::uint32_t candidate : candidates) { largest = std::max(largest, ++bucket_sizes[score_guess(guess, answers[candidate])]); }
+            return largest;
+        }
+    }
+
+    Adversary::Adversary(const Dictionary::WordList guesses, const Dictionary::WordList answers, TerminalUI::WorkerPool* workers) :
+        guesses(guesses), answers(answers), workers(workers), bucket_sizes(pattern_count(answers.word_length())) {
+        reset();
+    }
+
+    void Adversary::reset() {
+        candidates_.resize(answers.size());
+        for (std::uint32_t i = 0; i < candidates_.size(); ++i) { candidates_[i] = i; }
+    }
+
+    Pattern Adversary::respond(const std::string_view guess) {
+        // one pass of scoring, patterns are kept for filtering
+        patterns.resize(candidates_.size());
+        score_guess_batch(guess, answers, candidates_, patterns);
+        std::ranges::fill(bucket_sizes, 0);
+        for (const Pattern pattern : patterns) { bucket_sizes[pattern]++; }
+
+        // solved group (one word, the guess) is kept only when every group has one word, and there's no other
+        const Pattern solved = solved_pattern(answers.word_length());
+        const std::uint32_t largest = std::ranges::max(bucket_sizes);
+        std::vector<Pattern> tied;
+        for (std::size_t pattern = 0; pattern < bucket_sizes.size(); ++pattern) {
+            if (bucket_sizes[pattern] == largest && pattern != solved) { tied.push_back(static_cast<Pattern>(pattern)); }
+        }
+        if (tied.empty()) { tied.push_back(solved); }
+
+        Pattern kept = tied.front();
+        if (tied.size() > 1) {
+            std::vector<std::vector<std::uint32_t>> groups(tied.size());
+            for (std::size_t i = 0; i < candidates_.size(); ++i) {
+                if (const auto group = std::ranges::find(tied, patterns[i]); group != tied.end()) { groups[group - tied.begin()].push_back(candidates_[i]); }
+            }
+            kept = tied[breakTie(groups)];
+        }
+
+        std::size_t kept_count = 0;
+        for (std::size_t i = 0; i < candidates_.size(); ++i) {
+            if (patterns[i] == kept) { candidates_[kept_count++] = candidates_[i]; }
+        }
+        candidates_.resize(kept_count);
+        return kept;
+    }
+
+    // Private:
+    std::size_t Adversary::breakTie(const std::vector<std::vector<std::uint32_t>>& groups) const {
+        const std::size_t threads = workers != nullptr ? workers->size() : 1;
+        std::size_t group_words = 0, own_work = 0;
+        for (const auto& group : groups) {
+            group_words += group.size();
+            own_work += group.size() * group.size();
+        }
+        // whole guess list, or just words of the group (player can always guess one of them), or no look-ahead at all
+        const bool whole_list = group_words * guesses.size() <= lookahead_budget * threads;
+        if (!whole_list && own_work > lookahead_budget * threads) { return 0; }
+
+        // player's best next guess against every group (smallest largest group it leaves), minimum of tasks is taken
+        const std::size_t task_count = whole_list ? threads * tasks_per_thread : groups.size();
+        std::vector<std::vector<std::uint32_t>> best(task_count, std::vector<std::uint32_t>(groups.size(), std::numeric_limits<std::uint32_t>::max()));
+        const auto task = [&](const std::size_t index) {
+            std::vector<std::uint32_t> scratch(pattern_count(answers.word_length()));
+            if (whole_list) {
+                const std::size_t begin = guesses.size() * index / task_count, end = guesses.size() * (index + 1) / task_count;
+                for (std::size_t g = 0; g < groups.size(); ++g) {
+                    for (std::size_t guess = begin; guess < end && best[index][g] > 1; ++guess) {
+                        best[index][g] = std::min(best[index][g], largest_group(guesses[guess], answers, groups[g], scratch));
+                    }
+                }
+                return;
+            }
+            for (std::size_t i = 0; i < groups[index].size() && best[index][index] > 1; ++i) {
+                best[index][index] = std::min(best[index][index], largest_group(answers[groups[index][i]], answers, groups[index], scratch));
+            }
+        };
+        if (workers != nullptr) { workers->run(task_count, task); }
+        else { for (std::size_t index = 0; index < task_count; ++index) { task(index); } }
+
+        // group that stays the largest after player's best reply (ties go to the lowest pattern, so answer is always the same)
+        std::size_t kept = 0;
+        std::uint32_t kept_score = 0;
+        for (std::size_t g = 0; g < groups.size(); ++g) {
+            std::uint32_t score = std::numeric_limits<std::uint32_t>::max();
+            for (const auto& task_best : best) { score = std::min(score, task_best[g]); }
+            if (score > kept_score) {
+                kept = g;
+                kept_score = score;
+            }
+        }
+        return kept;
+    }
+}
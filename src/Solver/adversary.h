@@ -0,0 +1,52 @@
+#ifndef ADVERSARY_H
+#define ADVERSARY_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "feedback.hpp"
+#include "../Dictionary/word_list.hpp"
+#include "../TerminalUI/worker_pool.h"
+
+namespace Solver {
+    /*
+     *  Opponent of adversarial ("Absurdle") mode: no answer is chosen, after every guess remaining candidates are split
+     *  by feedback they would give, and feedback of the largest group is returned (that group is kept).
+     *  Candidates are scored once per guess, the same patterns are used for counting groups and for filtering.
+     *
+     *  Groups of the same size are compared two plies ahead: the one where player's best next guess still leaves
+     *  the most candidates wins. Look-ahead is split between worker threads and limited by amount of work,
+     *  so the answer comes within a frame: next guesses are whole guess list when it's cheap enough,
+     *  candidates of the group otherwise, and without look-ahead ties go to the lowest pattern.
+     */
+    class Adversary {
+        Dictionary::WordList guesses;
+        Dictionary::WordList answers;
+        // look-ahead runs only on calling thread without it
+        TerminalUI::WorkerPool* workers;
+
+        std::vector<std::uint32_t> candidates_{};
+        // scratch, reused between guesses
+        std::vector<Pattern> patterns{};
+        std::vector<std::uint32_t> bucket_sizes{};
+
+        // candidates of groups that are tied for the largest, returns index of the one to keep
+        [[nodiscard]] std::size_t breakTie(const std::vector<std::vector<std::uint32_t>>& groups) const;
+
+        public:
+            // word lists are views (they have to outlive adversary), both need the same word length
+            Adversary(Dictionary::WordList guesses, Dictionary::WordList answers, TerminalUI::WorkerPool* workers = nullptr);
+
+            // all answers are possible again
+            void reset();
+            // feedback for guess (guess has to be from guesses), only candidates that give it are kept
+            Pattern respond(std::string_view guess);
+
+            // answers (indices into answer list) that still fit all feedback, never empty
+            [[nodiscard]] std::span<const std::uint32_t> candidates() const { return candidates_; }
+    };
+}
+
+#endif //ADVERSARY_H
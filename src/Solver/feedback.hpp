@@ -0,0 +1,82 @@
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Solver {
+    enum class LetterState : std::uint8_t {
+        ABSENT,
+        PRESENT,
+        CORRECT
+    };
+
+    constexpr unsigned int max_word_length = 8;
+
+    /*
+     *  Feedback for whole guess packed into one number: base-3 digit per letter (first letter is the least significant digit).
+     *  For 8 letters it's at most 3^8 = 6561 patterns, so it fits in 16 bits and can be used directly as bucket index.
+     */
+    using Pattern = std::uint16_t;
+
+    constexpr std::array<Pattern, max_word_length + 1> pattern_powers = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+    constexpr LetterState letter_state(const Pattern pattern, const unsigned int position) {
+        return static_cast<LetterState>(pattern / pattern_powers[position] % 3);
+    }
+    // number of different patterns for words of given length
+    constexpr unsigned int pattern_count(const unsigned int word_length) { return pattern_powers[word_length]; }
+    // pattern of correctly guessed word
+    constexpr Pattern solved_pattern(const unsigned int word_length) { return static_cast<Pattern>(pattern_powers[word_length] - 1); }
+
+    /*
+     *  Wordle scoring: exact matches are marked first, then remaining letters are marked as present
+     *  only as many times as they are still unmatched in the answer (so duplicated letters are handled correctly).
+     *  Both words have to be lowercase and of the same length.
+     */
+    constexpr Pattern score_guess(const std::string_view guess, const std::string_view answer) {
+        std::array<std::uint8_t, 26> unmatched{};
+        Pattern pattern = 0;
+
+        for (unsigned int c = 0; c < guess.size(); ++c) {
+            if (guess[c] == answer[c]) { pattern += 2 * pattern_powers[c]; }
+            else { unmatched[answer[c] - 'a']++; }
+        }
+        for (unsigned int c = 0; c < guess.size(); ++c) {
+            if (guess[c] != answer[c] && unmatched[guess[c] - 'a'] > 0) {
+                unmatched[guess[c] - 'a']--;
+                pattern += pattern_powers[c];
+            }
+        }
+        return pattern;
+    }
+
+    // "speed" against "abide": only first "e" is present, second one is absent
+    static_assert(score_guess("speed", "abide") == 1 * pattern_powers[2] + 1 * pattern_powers[4]);
+    static_assert(score_guess("crane", "crane") == solved_pattern(5));
+
+    /*
+     *  What feedback of all guesses so far says about every letter, one bit per letter (bit 0 is 'a').
+     *  Masks only grow, so they are updated with each guess instead of going over all guesses again.
+     *  Letter can be in more of them (absent duplicate of present letter), the best state is the one that counts.
+     */
+    struct LetterMasks {
+        std::uint32_t absent = 0;
+        std::uint32_t present = 0;
+        std::uint32_t correct = 0;
+
+        constexpr void add(const std::string_view guess, const Pattern pattern) {
+            for (unsigned int c = 0; c < guess.size(); ++c) {
+                const std::uint32_t bit = 1u << (guess[c] - 'a');
+                switch (letter_state(pattern, c)) {
+                    case LetterState::CORRECT: correct |= bit; break;
+                    case LetterState::PRESENT: present |= bit; break;
+                    case LetterState::ABSENT: absent |= bit; break;
+                }
+            }
+        }
+    };
+}
+
+#endif //FEEDBACK_H
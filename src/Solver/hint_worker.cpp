@@ -0,0 +1,84 @@
+#include "hint_worker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "../Diagnostics/memory_accounting.h"
+
+namespace Solver {
+    namespace {
+        // guesses scored between checks of cancel flag (a few milliseconds with all answers as candidates)
+        constexpr std::size_t guesses_per_chunk = 512;
+    }
+
+    HintWorker::HintWorker(const unsigned int thread_count) :
+        pool(thread_count > 1 ? std::make_unique<TerminalUI::WorkerPool>(thread_count - 1) : nullptr), thread(&HintWorker::work, this) {}
+
+    std::shared_ptr<PendingHint> HintWorker::submit(const Dictionary::WordList guesses, const Dictionary::WordList answers, std::vector<std::uint32_t> candidates) {
+        auto hint = std::make_shared<PendingHint>(guesses, answers, std::move(candidates));
+        {
+            std::lock_guard lock(mutex);
+            queued.push_back(hint);
+        }
+        wake.notify_one();
+        return hint;
+    }
+
+    void HintWorker::close() {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) { return; }
+            stopping = true;
+            for (const auto& hint : queued) { hint->cancel(); }
+            queued.clear();
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    HintWorker::~HintWorker() {
+        close();
+    }
+
+    // Private:
+    void HintWorker::work() {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SOLVER);
+        while (true) {
+            std::shared_ptr<PendingHint> hint;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this] { return stopping || !queued.empty(); });
+                if (stopping) { return; }
+                hint = std::move(queued.front());
+                queued.pop_front();
+            }
+            if (!hint->cancelled.load(std::memory_order_relaxed)) { compute(*hint); }
+        }
+    }
+
+    void HintWorker::compute(PendingHint& hint) const {
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t guess_count = hint.guesses.size();
+        const std::size_t chunk_count = (guess_count + guesses_per_chunk - 1) / guesses_per_chunk;
+
+        std::vector<GuessChoice> results(chunk_count);
+        const std::function<void(std::size_t)> score_chunk = [&](const std::size_t chunk) {
+            if (hint.cancelled.load(std::memory_order_relaxed)) { return; }
+            const std::size_t begin = chunk * guesses_per_chunk;
+            results[chunk] = best_guess(hint.guesses, hint.answers, hint.candidates, begin, std::min(begin + guesses_per_chunk, guess_count));
+        };
+        if (pool != nullptr) {
+            pool->run(chunk_count, score_chunk);
+        } else {
+            for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) { score_chunk(chunk); }
+        }
+        if (hint.cancelled.load(std::memory_order_relaxed)) { return; }
+
+        for (const GuessChoice& result : results) {
+            if (result.better_than(hint.choice)) { hint.choice = result; }
+        }
+        hint.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        hint.ready.store(true, std::memory_order_release);
+    }
+}
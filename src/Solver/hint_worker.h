@@ -0,0 +1,80 @@
+#ifndef HINT_WORKER_H
+#define HINT_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "partition.hpp"
+#include "../Dictionary/word_list.hpp"
+#include "../TerminalUI/worker_pool.h"
+
+namespace Solver {
+    // hint queued on HintWorker, game polls it (never waits for it) and cancels it when it's not needed anymore
+    class PendingHint {
+        friend class HintWorker;
+
+        // word lists are views (storage has to outlive worker), candidates are the game's at the moment hint was asked for
+        Dictionary::WordList guesses;
+        Dictionary::WordList answers;
+        std::vector<std::uint32_t> candidates;
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> ready{false};
+        // written by worker before ready is set
+        GuessChoice choice{};
+        long long milliseconds = 0;
+
+        public:
+            PendingHint(const Dictionary::WordList guesses, const Dictionary::WordList answers, std::vector<std::uint32_t> candidates) :
+                guesses(guesses), answers(answers), candidates(std::move(candidates)) {}
+
+            // worker skips hint if it hasn't started it yet, or stops it after current chunk of guesses
+            void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+            [[nodiscard]] bool isReady() const { return ready.load(std::memory_order_acquire); }
+            // result, only after isReady()
+            [[nodiscard]] std::size_t guess() const { return choice.guess; }
+            [[nodiscard]] long long computeMilliseconds() const { return milliseconds; }
+    };
+
+    /*
+     *  Computes hints out of the book on its own thread (one at a time, in order they were asked for),
+     *  so neither render loop nor server thread ever waits for them. Guesses are scored in chunks
+     *  (split between pool threads, if there are any), cancelled hint is dropped after current chunk.
+     *  One worker can be shared by all games (and server sessions).
+     */
+    class HintWorker {
+        // scoring threads in addition to worker thread (none when worker has just one thread)
+        std::unique_ptr<TerminalUI::WorkerPool> pool;
+
+        std::mutex mutex{};
+        std::condition_variable wake{};
+        std::deque<std::shared_ptr<PendingHint>> queued{};
+        bool stopping = false;
+        std::thread thread;
+
+        void work();
+        void compute(PendingHint& hint) const;
+
+        public:
+            // threads used for scoring of one hint (worker thread included)
+            explicit HintWorker(unsigned int thread_count = 1);
+
+            HintWorker(const HintWorker&) = delete;
+            HintWorker& operator=(const HintWorker&) = delete;
+
+            // queues best guess of guesses for candidates (indices into answers)
+            std::shared_ptr<PendingHint> submit(Dictionary::WordList guesses, Dictionary::WordList answers, std::vector<std::uint32_t> candidates);
+
+            // cancels queued hints and stops the thread (waits for current chunk at most), storage of word lists can be released after it
+            void close();
+
+            ~HintWorker();
+    };
+}
+
+#endif //HINT_WORKER_H
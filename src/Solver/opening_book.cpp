@@ -0,0 +1,122 @@
+#include "opening_book.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace Solver {
+    namespace {
+        constexpr char book_magic[8] = {'W', 'O', 'R', 'D', 'L', 'Y', 'O', 'B'};
+        constexpr std::uint32_t book_version = 1;
+
+        std::string error_message(const std::string& action, const std::string& path) {
+            return action + " " + path + ": " + std::strerror(errno);
+        }
+
+        bool write_all(const int fd, const char* data, std::size_t size) {
+            while (size > 0) {
+                const ssize_t written = ::write(fd, data, size);
+                if (written < 0 && errno == EINTR) { continue; }
+                if (written <= 0) { return false; }
+                data += written;
+                size -= written;
+            }
+            return true;
+        }
+    }
+
+    std::uint64_t OpeningBook::fingerprint(const Dictionary::WordList words) {
+        // FNV-1a over length and letters
+        std::uint64_t hash = 14695981039346656037ULL;
+        hash = (hash ^ words.word_length()) * 1099511628211ULL;
+        for (const char c : words.data()) { hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL; }
+        return hash;
+    }
+
+    void OpeningBook::write(const std::string& path, Header header, const std::vector<Node>& nodes, const std::vector<Edge>& edges) {
+        std::memcpy(header.magic, book_magic, sizeof(book_magic));
+        header.version = book_version;
+        header.node_count = nodes.size();
+        header.edge_count = edges.size();
+
+        /*
+         *  Book is written to temporary file, synced, and renamed over the old one, so crash (or full disk) never leaves
+         *  empty or cut book under its name. Directory is synced after rename, so the new name survives power failure too.
+         */
+        const std::string temporary_path = path + ".tmp." + std::to_string(getpid());
+        const int fd = open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd == -1) { throw std::runtime_error("Can't write opening book: " + error_message("Can't create", temporary_path)); }
+
+        std::optional<std::string> error;
+        if (!write_all(fd, reinterpret_cast<const char*>(&header), sizeof(header))
+            || !write_all(fd, reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node))
+            || !write_all(fd, reinterpret_cast<const char*>(edges.data()), edges.size() * sizeof(Edge))) {
+            error = error_message("Can't write", temporary_path);
+        }
+        else if (fsync(fd) == -1) { error = error_message("Can't sync", temporary_path); }
+        // errors of delayed writes (NFS) are reported by close
+        if (close(fd) == -1 && !error.has_value()) { error = error_message("Can't close", temporary_path); }
+        if (!error.has_value() && rename(temporary_path.c_str(), path.c_str()) == -1) { error = error_message("Can't rename to", path); }
+        if (error.has_value()) {
+            unlink(temporary_path.c_str());
+            throw std::runtime_error("Can't write opening book: " + error.value());
+        }
+
+        const std::size_t separator = path.rfind('/');
+        const std::string directory = separator == std::string::npos ? "." : separator == 0 ? "/" : path.substr(0, separator);
+        const int directory_fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directory_fd == -1) { throw std::runtime_error("Can't write opening book: " + error_message("Can't open", directory)); }
+        const bool synced = fsync(directory_fd) == 0;
+        if (!synced) { error = error_message("Can't sync", directory); }
+        close(directory_fd);
+        if (!synced) { throw std::runtime_error("Can't write opening book: " + error.value()); }
+    }
+
+    OpeningBook::OpeningBook(const std::string& path) : file(path) {
+        const auto bytes = file.bytes();
+        if (bytes.size() < sizeof(Header)) { throw std::runtime_error("Not an opening book: " + path); }
+
+        // mapping is page aligned, and every part of the file keeps alignment of its structs
+        header_ = reinterpret_cast<const Header*>(bytes.data());
+        const std::size_t expected_size = sizeof(Header) + header_->node_count * sizeof(Node) + header_->edge_count * sizeof(Edge);
+        if (std::memcmp(header_->magic, book_magic, sizeof(book_magic)) != 0 || header_->version != book_version
+            || header_->node_count == 0 || bytes.size() != expected_size) {
+            throw std::runtime_error("Not an opening book (or made by other version): " + path);
+        }
+        nodes_ = reinterpret_cast<const Node*>(bytes.data() + sizeof(Header));
+        edges_ = reinterpret_cast<const Edge*>(bytes.data() + sizeof(Header) + header_->node_count * sizeof(Node));
+
+        // edges pointing outside of the book would make lookups read random memory
+        for (std::uint32_t node = 0; node < header_->node_count; ++node) {
+            if (static_cast<std::uint64_t>(nodes_[node].first_edge) + nodes_[node].edge_count > header_->edge_count) {
+                throw std::runtime_error("Opening book is corrupted: " + path);
+            }
+        }
+        for (std::uint32_t edge = 0; edge < header_->edge_count; ++edge) {
+            if (edges_[edge].node >= header_->node_count) { throw std::runtime_error("Opening book is corrupted: " + path); }
+        }
+    }
+
+    bool OpeningBook::matches(const Dictionary::WordList guesses, const Dictionary::WordList answers) const {
+        return header_ != nullptr
+            && header_->word_length == answers.word_length()
+            && header_->guesses_fingerprint == fingerprint(guesses)
+            && header_->answers_fingerprint == fingerprint(answers);
+    }
+
+    std::string_view OpeningBook::guess(const NodeIndex node) const {
+        return {nodes_[node].guess, header_->word_length};
+    }
+
+    std::optional<OpeningBook::NodeIndex> OpeningBook::next(const NodeIndex node, const Pattern pattern) const {
+        const Edge* begin = edges_ + nodes_[node].first_edge;
+        const Edge* end = begin + nodes_[node].edge_count;
+        const Edge* edge = std::lower_bound(begin, end, pattern, [](const Edge& current, const Pattern value) { return current.pattern < value; });
+        if (edge == end || edge->pattern != pattern) { return std::nullopt; }
+        return edge->node;
+    }
+}
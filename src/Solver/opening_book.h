@@ -0,0 +1,76 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "feedback.hpp"
+#include "../Dictionary/mapped_file.h"
+#include "../Dictionary/word_list.hpp"
+
+namespace Solver {
+    /*
+     *  Precomputed decision tree of best guesses (made by wordly_book tool), mapped from flat file.
+     *  Node is a guess, and its edges lead to next guess for every feedback pattern (edges are sorted by pattern),
+     *  so looking up next guess is just a binary search over at most a few hundred edges, no matter how many words there are.
+     *  Tree can be depth limited, game computes hints itself after it leaves the book.
+     *
+     *  File: header, nodes (root is the first one), edges. Book is valid only for word lists it was made for (fingerprints).
+     */
+    class OpeningBook {
+        public:
+            struct Header {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t word_length;
+                std::uint32_t depth;            // guesses covered by the book (0 if whole tree)
+                std::uint32_t node_count;
+                std::uint32_t edge_count;
+                std::uint32_t reserved;
+                std::uint64_t guesses_fingerprint;
+                std::uint64_t answers_fingerprint;
+            };
+            struct Node {
+                char guess[Solver::max_word_length];
+                std::uint32_t first_edge;
+                std::uint16_t edge_count;
+                std::uint16_t candidate_count;  // answers still possible in this node (saturated at 65535)
+            };
+            struct Edge {
+                Pattern pattern;
+                std::uint16_t reserved;
+                std::uint32_t node;
+            };
+            using NodeIndex = std::uint32_t;
+
+            // identifies word list (its words, and their length)
+            static std::uint64_t fingerprint(Dictionary::WordList words);
+            // writes book atomically (synced temporary file and rename), throws std::runtime_error if it can't be written
+            static void write(const std::string& path, Header header, const std::vector<Node>& nodes, const std::vector<Edge>& edges);
+
+            OpeningBook() = default;
+            // throws std::runtime_error if file can't be mapped or it's not a valid book
+            explicit OpeningBook(const std::string& path);
+
+            // true if book was made for these lists
+            [[nodiscard]] bool matches(Dictionary::WordList guesses, Dictionary::WordList answers) const;
+            [[nodiscard]] const Header& header() const { return *header_; }
+
+            [[nodiscard]] NodeIndex root() const { return 0; }
+            [[nodiscard]] std::string_view guess(NodeIndex node) const;
+            [[nodiscard]] std::uint16_t candidateCount(const NodeIndex node) const { return nodes_[node].candidate_count; }
+            // node after guess of 'node' got 'pattern' (nothing if book doesn't go further)
+            [[nodiscard]] std::optional<NodeIndex> next(NodeIndex node, Pattern pattern) const;
+
+        private:
+            Dictionary::MappedFile file{};
+            const Header* header_ = nullptr;
+            const Node* nodes_ = nullptr;
+            const Edge* edges_ = nullptr;
+    };
+}
+
+#endif //OPENING_BOOK_H
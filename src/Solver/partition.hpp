@@ -0,0 +1,71 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "feedback.hpp"
+#include "../Dictionary/word_list.hpp"
+
+namespace Solver {
+    /*
+     *  Candidates (answers that are still possible) are split into buckets by feedback they would give for a guess.
+     *  Guess is as good as its buckets are small: score is sum of squared bucket sizes,
+     *  which is candidate count times expected number of candidates left after the guess (lower is better).
+     */
+
+    // feedback of one guess for many answers at once ('patterns' has the same size as 'indices', indices point into answers)
+    inline void score_guess_batch(const std::string_view guess, const Dictionary::WordList answers, const std::span<const std::uint32_t> indices,
+                                  const std::span<Pattern> patterns) {
+        for (std::size_t i = 0; i < indices.size(); ++i) { patterns[i] = score_guess(guess, answers[indices[i]]); }
+    }
+
+    // counts candidates per pattern ('bucket_sizes' has to have pattern_count(word_length) entries, it's overwritten)
+    inline void partition_sizes(const std::string_view guess, const Dictionary::WordList answers, const std::span<const std::uint32_t> candidates,
+                                const std::span<std::uint32_t> bucket_sizes) {
+        std::ranges::fill(bucket_sizes, 0);
+        for (const std::uint32_t candidate : candidates) { bucket_sizes[score_guess(guess, answers[candidate])]++; }
+    }
+
+    struct GuessChoice {
+        std::size_t guess = 0;                                     // index into guesses
+        std::uint64_t score = std::numeric_limits<std::uint64_t>::max();
+        bool is_candidate = false;                                 // guess can also be the answer
+
+        // lower score wins, then guess that can be the answer, then earlier guess (so result doesn't depend on how work was split)
+        [[nodiscard]] bool better_than(const GuessChoice& other) const {
+            if (score != other.score) { return score < other.score; }
+            if (is_candidate != other.is_candidate) { return is_candidate; }
+            return guess < other.guess;
+        }
+    };
+
+    // best of guesses [begin, end) for candidates, range can be split between threads and results combined with better_than()
+    inline GuessChoice best_guess(const Dictionary::WordList guesses, const Dictionary::WordList answers, const std::span<const std::uint32_t> candidates,
+                                  const std::size_t begin, const std::size_t end) {
+        std::vector<std::uint32_t> bucket_sizes(pattern_count(answers.word_length()));
+        const Pattern solved = solved_pattern(answers.word_length());
+
+        GuessChoice best;
+        for (std::size_t guess = begin; guess < end; ++guess) {
+            partition_sizes(guesses[guess], answers, candidates, bucket_sizes);
+            std::uint64_t score = 0;
+            for (const std::uint32_t size : bucket_sizes) { score += static_cast<std::uint64_t>(size) * size; }
+
+            const GuessChoice choice{guess, score, bucket_sizes[solved] > 0};
+            if (choice.better_than(best)) { best = choice; }
+        }
+        return best;
+    }
+
+    // keeps candidates that would give 'pattern' for 'guess'
+    inline void filter_candidates(const std::string_view guess, const Pattern pattern, const Dictionary::WordList answers, std::vector<std::uint32_t>& candidates) {
+        std::erase_if(candidates, [&](const std::uint32_t candidate) { return score_guess(guess, answers[candidate]) != pattern; });
+    }
+}
+
+#endif //PARTITION_H
@@ -0,0 +1,21 @@
+#include "cache_directory.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <sys/stat.h>
+
+namespace TerminalUI {
+    std::string cacheDirectory() {
+        std::string base;
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0') { base = xdg; }
+        else if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+            base = std::string(home) + "/.cache";
+            mkdir(base.c_str(), 0755);
+        }
+        else { return ""; }
+
+        const std::string directory = base + "/wordly";
+        if (mkdir(directory.c_str(), 0755) == -1 && errno != EEXIST) { return ""; }
+        return directory;
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef CACHE_DIRECTORY_H
+#define CACHE_DIRECTORY_H
+
+#include <string>
+
+namespace TerminalUI {
+    // $XDG_CACHE_HOME/wordly or ~/.cache/wordly, created if missing (empty if none of them can be created)
+    std::string cacheDirectory();
+}
+
+#endif //CACHE_DIRECTORY_H
@@ -0,0 +1,182 @@
+#include "capabilities.h"
+#include "cache_directory.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <poll.h>
+#include <unistd.h>
+
+namespace TerminalUI {
+    namespace {
+        constexpr char escape = '\033';
+        constexpr const char* cache_header = "wordly-terminal-capabilities 1";
+
+        // DECRQM answer is "<mode>;<value>", value 1 or 2 means mode is known (set or reset), 3 that it's permanently set
+        std::optional<unsigned int> supported_mode(const std::string_view parameters) {
+            const std::size_t separator = parameters.find(';');
+            if (separator == std::string_view::npos || separator + 1 >= parameters.size()) { return std::nullopt; }
+
+            unsigned int mode = 0;
+            for (const char c : parameters.substr(0, separator)) {
+                if (c < '0' || c > '9') { return std::nullopt; }
+                mode = mode * 10 + (c - '0');
+            }
+            const char value = parameters[separator + 1];
+            if (value != '1' && value != '2' && value != '3') { return std::nullopt; }
+            return mode;
+        }
+
+        // one file per $TERM (empty if there is no $TERM, or no cache directory)
+        std::string cache_path() {
+            const char* term = std::getenv("TERM");
+            if (term == nullptr || *term == '\0') { return ""; }
+            const std::string directory = cacheDirectory();
+            if (directory.empty()) { return ""; }
+
+            // $TERM is used in file name, so anything else than plain characters is replaced
+            std::string name = term;
+            for (char& c : name) {
+                const bool plain = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.';
+                if (!plain) { c = '_'; }
+            }
+            return directory + "/terminal." + name + ".caps";
+        }
+
+        std::optional<Capabilities> load_cache(const std::string& path) {
+            std::ifstream file(path);
+            std::string header;
+            if (!std::getline(file, header) || header != cache_header) { return std::nullopt; }
+
+            Capabilities capabilities;
+            std::string name;
+            int value = 0;
+            while (file >> name >> value) {
+                if (name == "synchronized_output") { capabilities.synchronized_output = value != 0; }
+                else if (name == "bracketed_paste") { capabilities.bracketed_paste = value != 0; }
+                else if (name == "truecolor") { capabilities.truecolor = value != 0; }
+            }
+            return capabilities;
+        }
+
+        // cache is just an optimization, so failing to write it is ignored
+        void save_cache(const std::string& path, const Capabilities capabilities) {
+            std::ofstream file(path, std::ios::trunc);
+            file << cache_header << '\n'
+                 << "synchronized_output " << capabilities.synchronized_output << '\n'
+                 << "bracketed_paste " << capabilities.bracketed_paste << '\n'
+                 << "truecolor " << capabilities.truecolor << '\n';
+        }
+
+        bool write_all(const int fd, std::string_view bytes) {
+            while (!bytes.empty()) {
+                const ssize_t written = write(fd, bytes.data(), bytes.size());
+                if (written == -1 && errno == EINTR) { continue; }
+                if (written <= 0) { return false; }
+                bytes.remove_prefix(written);
+            }
+            return true;
+        }
+    }
+
+    std::string_view CapabilityProbe::queries() {
+        // modes 2026 and 2004, truecolor background set and read back (then reset), and DA1 as the last one
+        return "\033[?2026$p"
+               "\033[?2004$p"
+               "\033[48;2;1;2;3m\033P$qm\033\\\033[0m"
+               "\033[c";
+    }
+
+    bool CapabilityProbe::feed(const std::string_view bytes) {
+        responses.append(bytes);
+
+        std::size_t position = 0;
+        while (position < responses.size() && !finished) {
+            const std::string_view rest = std::string_view(responses).substr(position);
+            if (rest[0] != escape) { input += rest[0]; ++position; continue; }
+            // rest of the sequence didn't arrive yet
+            if (rest.size() < 3) { break; }
+
+            // private CSI: DECRQM report ("$y" at the end) or DA1 response ('c' at the end)
+            if (rest.starts_with("\033[?")) {
+                std::size_t end = 3;
+                while (end < rest.size() && (rest[end] < 0x40 || rest[end] > 0x7E)) { ++end; }
+                if (end == rest.size()) { break; }
+
+                const std::string_view sequence = rest.substr(0, end + 1);
+                if (sequence.back() == 'c') { finished = true; }
+                else if (sequence.ends_with("$y")) {
+                    const std::optional<unsigned int> mode = supported_mode(sequence.substr(3, sequence.size() - 5));
+                    if (mode == 2026u) { capabilities.synchronized_output = true; }
+                    if (mode == 2004u) { capabilities.bracketed_paste = true; }
+                }
+                else { input.append(sequence); }
+                position += sequence.size();
+                continue;
+            }
+            // DCS: DECRQSS response, "1$r" and current SGR when request was valid (truecolor is kept only if terminal supports it)
+            if (rest[1] == 'P') {
+                const std::size_t end = rest.find("\033\\");
+                if (end == std::string_view::npos) { break; }
+
+                const std::string_view report = rest.substr(2, end - 2);
+                if (report.starts_with("1$r") && report.find("48") != std::string_view::npos &&
+                    (report.find("1:2:3") != std::string_view::npos || report.find("1;2;3") != std::string_view::npos)) {
+                    capabilities.truecolor = true;
+                }
+                position += end + 2;
+                continue;
+            }
+
+            // other escape sequences are keys
+            input += rest[0];
+            ++position;
+        }
+
+        responses.erase(0, position);
+        return finished;
+    }
+
+    std::optional<Capabilities> CapabilityProbe::detect(const int input_fd, const int output_fd, std::string& unhandled_input, bool& replies_pending,
+                                                        const std::chrono::milliseconds timeout) {
+        replies_pending = false;
+        if (!isatty(input_fd) || !isatty(output_fd)) { return std::nullopt; }
+
+        const std::string path = cache_path();
+        if (!path.empty()) {
+            if (const std::optional<Capabilities> cached = load_cache(path)) { return cached; }
+        }
+
+        if (!write_all(output_fd, queries())) { return std::nullopt; }
+
+        CapabilityProbe probe;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        char bytes[256];
+        while (!probe.isFinished()) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) { break; }
+
+            pollfd descriptor{input_fd, POLLIN, 0};
+            const int ready = poll(&descriptor, 1, static_cast<int>(remaining.count()));
+            if (ready == -1 && errno == EINTR) { continue; }
+            if (ready <= 0) { break; }
+
+            const ssize_t length = read(input_fd, bytes, sizeof(bytes));
+            if (length == -1 && (errno == EINTR || errno == EAGAIN)) { continue; }
+            if (length <= 0) { break; }
+            probe.feed(std::string_view(bytes, length));
+        }
+
+        // keys (and unfinished sequences) go back to the app
+        unhandled_input += probe.input;
+        unhandled_input += probe.responses;
+
+        // terminal that didn't answer isn't cached, it could have been just slow
+        if (!probe.isFinished()) {
+            replies_pending = true;
+            return std::nullopt;
+        }
+        if (!path.empty()) { save_cache(path, probe.capabilities); }
+        return probe.capabilities;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef CAPABILITIES_H
+#define CAPABILITIES_H
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TerminalUI {
+    // features that differ between terminals (everything is off by default, so unknown terminal gets plain output)
+    struct Capabilities {
+        // mode 2026, frame is shown at once (no tearing while it's being written)
+        bool synchronized_output = false;
+        // mode 2004, pasted text is marked, so it can't be mistaken for typed keys
+        bool bracketed_paste = false;
+        // 24-bit colors
+        bool truecolor = false;
+    };
+
+    /*
+     *  Asks terminal what it supports: DECRQM for modes 2026 and 2004, DECRQSS for truecolor (SGR that is set and read back),
+     *  and DA1 at the end, which every terminal answers (and in order), so when it arrives there won't be any other response.
+     *  Results are cached per $TERM on disk, so only first start pays the round trip.
+     */
+    class CapabilityProbe {
+        std::string responses{};
+        // bytes that aren't responses (keys pressed while probing)
+        std::string input{};
+        Capabilities capabilities{};
+        bool finished = false;
+
+        public:
+            // queries written to terminal
+            static std::string_view queries();
+
+            // parses responses read so far, returns true when probe is finished (DA1 response arrived)
+            bool feed(std::string_view bytes);
+            [[nodiscard]] bool isFinished() const { return finished; }
+            [[nodiscard]] Capabilities result() const { return capabilities; }
+
+            /*
+             *  Probes terminal on given descriptors (input has to be in non-canonical mode, without echo),
+             *  or loads cached result for current $TERM. Nothing is returned if terminal didn't answer in time (or isn't a terminal).
+             *  Keys pressed during probe are appended to 'unhandled_input'. 'replies_pending' is set when queries were sent,
+             *  but terminal didn't answer all of them in time (rest of replies will come as input, see KeyDecoder::dropProbeReplies()).
+             */
+            static std::optional<Capabilities> detect(int input_fd, int output_fd, std::string& unhandled_input, bool& replies_pending,
+                                                      std::chrono::milliseconds timeout = std::chrono::milliseconds(200));
+    };
+}
+
+#endif //CAPABILITIES_H
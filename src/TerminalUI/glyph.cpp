@@ -0,0 +1,109 @@
+#include "glyph.h"
+
+#include <algorithm>
+#include <array>
+
+namespace TerminalUI {
+    namespace {
+        constexpr char32_t replacement_character = 0xFFFD;
+
+        struct CodePointRange {
+            char32_t first;
+            char32_t last;
+        };
+        // East Asian Wide and Fullwidth blocks, plus emoji (sorted, used for binary search)
+        constexpr std::array<CodePointRange, 17> wide_ranges = {{
+            {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2E80, 0x303E}, {0x3041, 0x33FF},
+            {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF}, {0xAC00, 0xD7A3},
+            {0xF900, 0xFAFF}, {0xFE30, 0xFE4F}, {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6},
+            {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF}, {0x1F900, 0x1F9FF}, {0x20000, 0x2FFFD},
+            {0x30000, 0x3FFFD}
+        }};
+        constexpr std::array<CodePointRange, 6> zero_width_ranges = {{
+            {0x0300, 0x036F}, {0x200B, 0x200F}, {0x2028, 0x202E}, {0x20D0, 0x20FF},
+            {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}
+        }};
+
+        template <std::size_t N>
+        bool in_ranges(const std::array<CodePointRange, N> &ranges, const char32_t code_point) {
+            const auto range = std::ranges::upper_bound(ranges, code_point, {}, &CodePointRange::first);
+            return range != ranges.begin() && code_point <= std::prev(range)->last;
+        }
+
+        unsigned int encode_utf8(char32_t code_point, char* out) {
+            if (code_point < 0x80) { out[0] = static_cast<char>(code_point); return 1; }
+            if (code_point < 0x800) {
+                out[0] = static_cast<char>(0xC0 | code_point >> 6);
+                out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+                return 2;
+            }
+            if (code_point < 0x10000) {
+                out[0] = static_cast<char>(0xE0 | code_point >> 12);
+                out[1] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+                out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xF0 | code_point >> 18);
+            out[1] = static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+            out[2] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+            out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+            return 4;
+        }
+    }
+
+    GlyphTable::GlyphTable() {
+        // ASCII is stored at its own indices, so drawing doesn't need to care if glyph is ASCII or not
+        entries.resize(0x80);
+        for (std::uint16_t i = 0; i < 0x80; ++i) {
+            entries[i] = Entry{{static_cast<char>(i)}, 1, 1};
+        }
+        // index 0 (no character) is drawn as spacer
+        entries[0] = Entry{{' '}, 1, 1};
+    }
+
+    Glyph GlyphTable::intern(char32_t code_point) {
+        if (code_point < 0x80) { return {static_cast<char>(code_point)}; }
+        if (code_point > 0x10FFFF || code_point_width(code_point) == 0) { code_point = replacement_character; }
+
+        if (const auto found = indices.find(code_point); found != indices.end()) { return Glyph::fromIndex(found->second); }
+        // table is full (last index is reserved for wide continuation)
+        if (entries.size() >= Glyph::wide_continuation_index) { return {'?'}; }
+
+        Entry entry{};
+        entry.length = encode_utf8(code_point, entry.bytes);
+        entry.width = code_point_width(code_point);
+
+        const auto index = static_cast<std::uint16_t>(entries.size());
+        entries.push_back(entry);
+        indices.emplace(code_point, index);
+        return Glyph::fromIndex(index);
+    }
+
+    char32_t decode_utf8(const std::string_view text, std::size_t &position) {
+        const auto lead = static_cast<unsigned char>(text[position++]);
+        if (lead < 0x80) { return lead; }
+
+        unsigned int continuation_bytes;
+        char32_t code_point;
+        if ((lead & 0xE0) == 0xC0) { continuation_bytes = 1; code_point = lead & 0x1F; }
+        else if ((lead & 0xF0) == 0xE0) { continuation_bytes = 2; code_point = lead & 0x0F; }
+        else if ((lead & 0xF8) == 0xF0) { continuation_bytes = 3; code_point = lead & 0x07; }
+        else { return replacement_character; }
+
+        for (unsigned int i = 0; i < continuation_bytes; ++i) {
+            if (position >= text.size() || (static_cast<unsigned char>(text[position]) & 0xC0) != 0x80) { return replacement_character; }
+            code_point = code_point << 6 | (static_cast<unsigned char>(text[position++]) & 0x3F);
+        }
+        // reject overlong encodings and surrogates
+        constexpr char32_t minimal_values[] = {0, 0x80, 0x800, 0x10000};
+        if (code_point < minimal_values[continuation_bytes] || (code_point >= 0xD800 && code_point <= 0xDFFF)) { return replacement_character; }
+        return code_point;
+    }
+
+    unsigned int code_point_width(const char32_t code_point) {
+        if (code_point < 0x20 || (code_point >= 0x7F && code_point < 0xA0)) { return 0; }
+        if (code_point < 0x300) { return 1; }
+        if (in_ranges(zero_width_ranges, code_point)) { return 0; }
+        return in_ranges(wide_ranges, code_point) ? 2 : 1;
+    }
+}
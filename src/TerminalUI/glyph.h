@@ -0,0 +1,69 @@
+#ifndef GLYPH_H
+#define GLYPH_H
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TerminalUI {
+
+    /*
+     *  Character of a cell, as an index into GlyphTable (2 bytes per cell, no matter how long UTF-8 sequence is).
+     *  ASCII characters are their own indices, so they don't need any table (and can be created at compile time),
+     *  0 means no character. Right half of wide (2 cells) character is marked as continuation, and it's never drawn on its own.
+     */
+    struct Glyph {
+        std::uint16_t index = 0;
+
+        static constexpr std::uint16_t wide_continuation_index = 0xFFFF;
+
+        constexpr Glyph() = default;
+        constexpr Glyph(std::nullopt_t) {} // NOLINT(*-explicit-constructor) // same as optional<char>, for nicer Pixel initialization
+        // only ASCII, anything else has to go through GlyphTable (invalid bytes are shown as '?')
+        constexpr Glyph(const char character) : index(static_cast<unsigned char>(character) < 0x80 ? static_cast<unsigned char>(character) : '?') {} // NOLINT(*-explicit-constructor)
+
+        static constexpr Glyph fromIndex(const std::uint16_t index) { Glyph glyph; glyph.index = index; return glyph; }
+        static constexpr Glyph wideContinuation() { return fromIndex(wide_continuation_index); }
+
+        [[nodiscard]] constexpr bool has_value() const { return index != 0; }
+        [[nodiscard]] constexpr bool is_ascii() const { return index < 0x80; }
+        [[nodiscard]] constexpr bool is_wide_continuation() const { return index == wide_continuation_index; }
+
+        constexpr bool operator==(const Glyph&) const = default;
+    };
+
+    /*
+     *  Interned UTF-8 sequences (one code point each) with cached display width, every Terminal has its own table.
+     *  Drawing a glyph is a lookup into flat vector, interning is a hash map lookup (but only for non-ASCII characters).
+     */
+    class GlyphTable {
+        struct Entry {
+            char bytes[4];
+            std::uint8_t length;
+            std::uint8_t width;
+        };
+        std::vector<Entry> entries;
+        std::unordered_map<char32_t, std::uint16_t> indices;
+
+        public:
+            GlyphTable();
+
+            // glyph for given code point (zero-width code points are not supported, they are interned as U+FFFD)
+            Glyph intern(char32_t code_point);
+
+            [[nodiscard]] std::string_view bytes(const Glyph glyph) const {
+                const Entry& entry = entries[glyph.index];
+                return {entry.bytes, entry.length};
+            }
+            // number of cells taken by glyph (1 or 2)
+            [[nodiscard]] unsigned int width(const Glyph glyph) const { return entries[glyph.index].width; }
+    };
+
+    // decodes one code point starting at position (and moves position past it), invalid sequences decode to U+FFFD
+    char32_t decode_utf8(std::string_view text, std::size_t &position);
+    // display width of code point in cells (0 for combining and other zero-width code points, 2 for wide ones)
+    unsigned int code_point_width(char32_t code_point);
+}
+
+#endif //GLYPH_H
@@ -0,0 +1,116 @@
+#include "key_decoder.h"
+
+#include <algorithm>
+
+namespace TerminalUI {
+    namespace {
+        constexpr char escape = '\033';
+        // longest escape sequence we wait for, anything longer is garbage (escape is then handled as separate key)
+        constexpr std::size_t max_sequence_length = 16;
+        // longest probe reply we wait for (DA1 reply lists all features of the terminal)
+        constexpr std::size_t max_reply_length = 64;
+        constexpr std::string_view paste_start = "\033[200~";
+        constexpr std::string_view paste_end = "\033[201~";
+    }
+
+    void KeyDecoder::feed(const std::string_view bytes) {
+        // drop already decoded keys, so buffer doesn't grow
+        if (offset > 0) {
+            pending.erase(0, offset);
+            offset = 0;
+        }
+        pending.append(bytes);
+    }
+
+    void KeyDecoder::dropProbeReplies(const std::chrono::steady_clock::time_point until) {
+        drop_probe_replies_until = until;
+    }
+
+    std::optional<int> KeyDecoder::next() {
+        std::string_view remaining;
+        std::size_t length = 0;
+        while (true) {
+            remaining = std::string_view(pending).substr(offset);
+            if (remaining.empty()) { return std::nullopt; }
+
+            if (drop_probe_replies_until.has_value()) {
+                if (std::chrono::steady_clock::now() >= drop_probe_replies_until.value()) { drop_probe_replies_until.reset(); }
+                else if (const std::optional<std::size_t> reply = probeReplyLength(remaining)) {
+                    if (reply.value() == 0) { return std::nullopt; }
+                    // DA1 is the last reply, nothing else is coming after it
+                    if (remaining[reply.value() - 1] == 'c') { drop_probe_replies_until.reset(); }
+                    offset += reply.value();
+                    continue;
+                }
+            }
+
+            length = keyLength(remaining);
+            if (length == 0) { return std::nullopt; }
+            offset += length;
+
+            const std::string_view key = remaining.substr(0, length);
+            if (key == paste_start) { in_paste = true; continue; }
+            if (key == paste_end) { in_paste = false; continue; }
+            // pasted text can't control the app
+            if (in_paste && (key[0] == escape || key[0] == '\r' || key[0] == '\n')) { continue; }
+            break;
+        }
+
+        unsigned int code = 0;
+        for (std::size_t i = 0; i < std::min<std::size_t>(length, 4); ++i) {
+            code |= static_cast<unsigned int>(static_cast<unsigned char>(remaining[i])) << (8 * i);
+        }
+        return static_cast<int>(code);
+    }
+
+    // Private:
+    std::size_t KeyDecoder::keyLength(const std::string_view bytes) {
+        const auto lead = static_cast<unsigned char>(bytes[0]);
+
+        if (lead == escape) {
+            if (bytes.size() < 2) { return 0; }
+            // CSI sequence: parameters and intermediate bytes, ended by final byte (@ to ~)
+            if (bytes[1] == '[') {
+                for (std::size_t i = 2; i < std::min(bytes.size(), max_sequence_length); ++i) {
+                    if (bytes[i] >= 0x40 && bytes[i] <= 0x7E) { return i + 1; }
+                }
+                return bytes.size() < max_sequence_length ? 0 : 1;
+            }
+            // SS3 sequence (arrows in application mode, F1-F4), always 3 bytes
+            if (bytes[1] == 'O') { return bytes.size() < 3 ? 0 : 3; }
+            // just escape key
+            return 1;
+        }
+
+        // UTF-8 character (length from lead byte)
+        std::size_t length = 1;
+        if ((lead & 0xE0) == 0xC0) { length = 2; }
+        else if ((lead & 0xF0) == 0xE0) { length = 3; }
+        else if ((lead & 0xF8) == 0xF0) { length = 4; }
+        return bytes.size() < length ? 0 : length;
+    }
+
+    std::optional<std::size_t> KeyDecoder::probeReplyLength(const std::string_view bytes) {
+        if (bytes[0] != escape || bytes.size() < 2) { return std::nullopt; }
+
+        // private CSI: DECRQM report ("$y" at the end) or DA1 reply ('c' at the end)
+        if (bytes[1] == '[') {
+            if (bytes.size() < 3) { return 0; }
+            if (bytes[2] != '?') { return std::nullopt; }
+            for (std::size_t i = 3; i < std::min(bytes.size(), max_reply_length); ++i) {
+                if (bytes[i] < 0x40 || bytes[i] > 0x7E) { continue; }
+                const std::string_view sequence = bytes.substr(0, i + 1);
+                if (sequence.back() == 'c' || sequence.ends_with("$y")) { return sequence.size(); }
+                return std::nullopt;
+            }
+            return bytes.size() < max_reply_length ? std::optional<std::size_t>(0) : std::nullopt;
+        }
+        // DCS (DECRQSS reply), ended by string terminator
+        if (bytes[1] == 'P') {
+            const std::size_t end = bytes.substr(0, max_reply_length).find("\033\\", 2);
+            if (end != std::string_view::npos) { return end + 2; }
+            return bytes.size() < max_reply_length ? std::optional<std::size_t>(0) : std::nullopt;
+        }
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef KEY_DECODER_H
+#define KEY_DECODER_H
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TerminalUI {
+    /*
+     *  Splits input bytes into keys, so keys that arrived together (fast typing, pasting, or network packets)
+     *  are still handled one by one, and keys split between reads are joined.
+     *  Key code is made from bytes of the key (first byte is least significant, up to 4 bytes),
+     *  so ASCII keys are just their value, and for example arrow down ("\033[B") is 4348699.
+     *  Escape sequence (or UTF-8 character) that is not complete yet waits for rest of its bytes.
+     *  Bracketed paste markers are dropped, and so are newlines and escape sequences inside of paste,
+     *  so pasted text is just typed (it can't for example submit a guess).
+     *  Replies to capability probe that arrived after it timed out can be dropped too, so they aren't typed as keys.
+     */
+    class KeyDecoder {
+        std::string pending{};
+        std::size_t offset = 0;
+        bool in_paste = false;
+        std::optional<std::chrono::steady_clock::time_point> drop_probe_replies_until{};
+
+        // length of the key at the beginning of bytes (0 if key isn't complete yet)
+        static std::size_t keyLength(std::string_view bytes);
+        // length of probe reply (DECRQM, DA1 or DCS) at the beginning of bytes (0 if it isn't complete yet, nothing if it's not a reply)
+        static std::optional<std::size_t> probeReplyLength(std::string_view bytes);
+
+        public:
+            void feed(std::string_view bytes);
+            /*
+             *  Drops probe replies until DA1 reply (terminal answers it last) or until deadline,
+             *  escape sequence that could be start of a reply waits for the rest of it meanwhile.
+             */
+            void dropProbeReplies(std::chrono::steady_clock::time_point until);
+            // next complete key (nothing if there isn't one)
+            std::optional<int> next();
+    };
+}
+
+#endif //KEY_DECODER_H
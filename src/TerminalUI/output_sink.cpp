@@ -0,0 +1,58 @@
+#include "output_sink.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace TerminalUI {
+    std::size_t kernelOutputQueue(const int file_descriptor) {
+        #ifdef TIOCOUTQ
+            // on Linux it's the same request as SIOCOUTQ, so it works for sockets too
+            int queued = 0;
+            if (ioctl(file_descriptor, TIOCOUTQ, &queued) == 0 && queued > 0) { return static_cast<std::size_t>(queued); }
+        #endif
+        return 0;
+    }
+
+    void FileDescriptorSink::write(const std::string_view bytes) {
+        // bytes that are still waiting go first, so order of output is kept
+        pending.append(bytes);
+        writePending();
+    }
+
+    void FileDescriptorSink::flushPending() {
+        if (!pending.empty()) { writePending(); }
+    }
+
+    void FileDescriptorSink::setNonBlocking(const bool enabled) {
+        if (enabled == non_blocking) { return; }
+        const int flags = fcntl(file_descriptor, F_GETFL);
+        if (flags < 0 || fcntl(file_descriptor, F_SETFL, enabled ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) < 0) { return; }
+        non_blocking = enabled;
+        flushPending();
+    }
+
+    FileDescriptorSink& FileDescriptorSink::standardOutput() {
+        static FileDescriptorSink sink(STDOUT_FILENO);
+        return sink;
+    }
+
+    // Private:
+    void FileDescriptorSink::writePending() {
+        std::size_t written = 0;
+        while (written < pending.size()) {
+            const ssize_t length = ::write(file_descriptor, pending.data() + written, pending.size() - written);
+            if (length < 0) {
+                if (errno == EINTR) { continue; }
+                // output is full, rest waits for next write (or flushPending)
+                if (errno == EAGAIN || errno == EWOULDBLOCK) { break; }
+                // nothing sensible to do when terminal is gone, frame is just lost
+                written = pending.size();
+                break;
+            }
+            written += static_cast<std::size_t>(length);
+        }
+        pending.erase(0, written);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+#include <string>
+#include <string_view>
+
+namespace TerminalUI {
+    /*
+     *  Destination of bytes produced by Terminal (escape codes and characters), whole frame is written at once.
+     *  By default it's stdout, but terminal can be bound to anything else (for example network connection).
+     *  Sink that never blocks keeps bytes its output didn't take yet, renderer holds frames back while any bytes are pending.
+     */
+    class OutputSink {
+        public:
+            virtual void write(std::string_view bytes) = 0;
+            // bytes written, but not delivered yet (kept by sink, or still in kernel output queue)
+            [[nodiscard]] virtual std::size_t pendingBytes() const { return 0; }
+            // tries to deliver pending bytes again, without blocking
+            virtual void flushPending() {}
+            virtual ~OutputSink() = default;
+    };
+
+    /*
+     *  Bytes written to descriptor that its other end didn't read yet (tty output queue, or unsent and unacknowledged socket data),
+     *  kernel buffers hide slow link from write() until they are full. 0 if system can't tell.
+     */
+    std::size_t kernelOutputQueue(int file_descriptor);
+
+    /*
+     *  Writes straight into file descriptor, blocking until all bytes are written by default.
+     *  In non-blocking mode bytes that descriptor doesn't take (EAGAIN) are kept and written first by next write or flushPending().
+     */
+    class FileDescriptorSink final : public OutputSink {
+        int file_descriptor;
+        bool non_blocking = false;
+        std::string pending{};
+
+        // writes as much of pending bytes as descriptor takes
+        void writePending();
+
+        public:
+            explicit FileDescriptorSink(int file_descriptor) : file_descriptor(file_descriptor) {}
+
+            void write(std::string_view bytes) override;
+            [[nodiscard]] std::size_t pendingBytes() const override { return pending.size() + kernelOutputQueue(file_descriptor); }
+            // bytes descriptor didn't take yet (waiting in sink)
+            [[nodiscard]] std::size_t unwrittenBytes() const { return pending.size(); }
+            void flushPending() override;
+            [[nodiscard]] int fileDescriptor() const { return file_descriptor; }
+            /*
+             *  Switches descriptor (O_NONBLOCK) and sink between modes,
+             *  going back to blocking mode writes out pending bytes (waiting for them).
+             */
+            void setNonBlocking(bool enabled);
+
+            // shared sink of standard output
+            static FileDescriptorSink& standardOutput();
+    };
+}
+
+#endif //OUTPUT_SINK_H
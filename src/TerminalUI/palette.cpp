@@ -0,0 +1,136 @@
+#include "palette.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace TerminalUI {
+    namespace {
+        // longest sequence is "\033[48;2;255;255;255m" (19 characters)
+        struct EscapeCode {
+            char sequence[20];
+        };
+        // [0] is 256-color (or basic) variant, [1] is 24-bit variant
+        using EscapeTable = std::array<std::array<EscapeCode, Palette::capacity>, 2>;
+
+        // ANSI escape codes for basic colors (same in both variants)
+        constexpr const char* BasicForegroundCodes[] = {
+            "", // None (Default color)
+            "\033[37m", // WHITE
+            "\033[30m", // BLACK
+            "\033[31m", // RED
+            "\033[32m", // GREEN
+            "\033[34m", // BLUE
+            "\033[33m"  // YELLOW
+        };
+        constexpr const char* BasicBackgroundCodes[] = {
+            "", // None (Default color)
+            "\033[47m", // WHITE
+            "\033[40m", // BLACK
+            "\033[41m", // RED
+            "\033[42m", // GREEN
+            "\033[44m", // BLUE
+            "\033[43m"  // YELLOW
+        };
+        constexpr unsigned int basic_color_count = std::size(BasicForegroundCodes);
+
+        // keys of interned colors, so the same color always gets the same index
+        enum class EntryKind : std::uint32_t { BASIC = 0, INDEXED = 1u << 24, RGB = 2u << 24 };
+
+        struct PaletteStorage {
+            EscapeTable foreground{};
+            EscapeTable background{};
+            std::array<std::uint32_t, Palette::capacity> keys{};
+            std::atomic<unsigned int> used{basic_color_count};
+            std::atomic<bool> truecolor{false};
+            std::mutex intern_mutex;
+
+            PaletteStorage() {
+                for (unsigned int i = 0; i < basic_color_count; ++i) {
+                    keys[i] = static_cast<std::uint32_t>(EntryKind::BASIC) | i;
+                    for (auto variant = 0; variant < 2; ++variant) {
+                        std::strcpy(foreground[variant][i].sequence, BasicForegroundCodes[i]);
+                        std::strcpy(background[variant][i].sequence, BasicBackgroundCodes[i]);
+                    }
+                }
+                const char* colorterm = std::getenv("COLORTERM");
+                truecolor = colorterm != nullptr && (std::strcmp(colorterm, "truecolor") == 0 || std::strcmp(colorterm, "24bit") == 0);
+            }
+        };
+
+        PaletteStorage& storage() {
+            static PaletteStorage palette;
+            return palette;
+        }
+
+        // nearest color in xterm 256-color palette (6x6x6 cube or grayscale ramp)
+        std::uint8_t nearest_indexed(const std::uint8_t red, const std::uint8_t green, const std::uint8_t blue) {
+            constexpr int cube_levels[] = {0, 95, 135, 175, 215, 255};
+            const auto cube_index = [&](const int value) {
+                return value < 48 ? 0 : value < 115 ? 1 : (value - 35) / 40;
+            };
+            const int r = cube_index(red), g = cube_index(green), b = cube_index(blue);
+            const auto distance = [&](const int cr, const int cg, const int cb) {
+                return (cr - red) * (cr - red) + (cg - green) * (cg - green) + (cb - blue) * (cb - blue);
+            };
+            const int cube_distance = distance(cube_levels[r], cube_levels[g], cube_levels[b]);
+
+            const int average = (red + green + blue) / 3;
+            const int gray_index = average > 238 ? 23 : (average - 3) / 10 < 0 ? 0 : (average - 3) / 10;
+            const int gray_level = 8 + gray_index * 10;
+            const int gray_distance = distance(gray_level, gray_level, gray_level);
+
+            return gray_distance < cube_distance ? 232 + gray_index : 16 + 36 * r + 6 * g + b;
+        }
+
+        Color intern(const std::uint32_t key, const std::uint8_t indexed, const std::uint8_t red, const std::uint8_t green, const std::uint8_t blue) {
+            PaletteStorage& palette = storage();
+            std::lock_guard lock(palette.intern_mutex);
+
+            const unsigned int used = palette.used.load(std::memory_order_relaxed);
+            for (unsigned int i = 0; i < used; ++i) {
+                if (palette.keys[i] == key) { return static_cast<Color>(i); }
+            }
+            if (used >= Palette::capacity) { throw std::runtime_error("Color palette is full!"); }
+
+            palette.keys[used] = key;
+            std::snprintf(palette.foreground[0][used].sequence, sizeof(EscapeCode), "\033[38;5;%um", indexed);
+            std::snprintf(palette.background[0][used].sequence, sizeof(EscapeCode), "\033[48;5;%um", indexed);
+            if ((key & static_cast<std::uint32_t>(EntryKind::RGB)) != 0) {
+                std::snprintf(palette.foreground[1][used].sequence, sizeof(EscapeCode), "\033[38;2;%u;%u;%um", red, green, blue);
+                std::snprintf(palette.background[1][used].sequence, sizeof(EscapeCode), "\033[48;2;%u;%u;%um", red, green, blue);
+            } else {
+                palette.foreground[1][used] = palette.foreground[0][used];
+                palette.background[1][used] = palette.background[0][used];
+            }
+            // publish entry only after its escape codes are written
+            palette.used.store(used + 1, std::memory_order_release);
+            return static_cast<Color>(used);
+        }
+    }
+
+    Color Palette::indexed(const std::uint8_t index) {
+        return intern(static_cast<std::uint32_t>(EntryKind::INDEXED) | index, index, 0, 0, 0);
+    }
+
+    Color Palette::rgb(const std::uint8_t red, const std::uint8_t green, const std::uint8_t blue) {
+        const std::uint32_t key = static_cast<std::uint32_t>(EntryKind::RGB) | red << 16 | green << 8 | blue;
+        return intern(key, nearest_indexed(red, green, blue), red, green, blue);
+    }
+
+    void Palette::setTruecolor(const bool enabled) { storage().truecolor = enabled; }
+    bool Palette::isTruecolor() { return storage().truecolor; }
+
+    const char* get_foreground_escape_code(const Color color) {
+        const PaletteStorage& palette = storage();
+        return palette.foreground[palette.truecolor.load(std::memory_order_relaxed)][static_cast<std::uint8_t>(color)].sequence;
+    }
+    const char* get_background_escape_code(const Color color) {
+        const PaletteStorage& palette = storage();
+        return palette.background[palette.truecolor.load(std::memory_order_relaxed)][static_cast<std::uint8_t>(color)].sequence;
+    }
+}
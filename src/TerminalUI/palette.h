@@ -0,0 +1,46 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+#include <cstdint>
+
+namespace TerminalUI {
+
+    /*
+     *  Color is just an index into global palette (one byte per color in every Pixel).
+     *  First entries are basic ANSI colors, any other color (256-color or 24-bit) has to be interned
+     *  through Palette first, and then it can be used the same way as predefined ones.
+     */
+    enum class Color : std::uint8_t {
+        NONE,
+        WHITE,
+        BLACK,
+        RED,
+        GREEN,
+        BLUE,
+        YELLOW
+    };
+
+    /*
+     *  Escape sequences are formatted once, when color is interned, so getting them while drawing is just a table lookup.
+     *  24-bit colors also have 256-color fallback precomputed (nearest color from xterm palette),
+     *  which one is used depends on setTruecolor() (by default it's taken from $COLORTERM).
+     *  Interning is thread safe, and lookups don't lock.
+     */
+    class Palette {
+        public:
+            static constexpr unsigned int capacity = 256;
+
+            // color from xterm 256-color palette (throws std::runtime_error if palette is full)
+            static Color indexed(std::uint8_t index);
+            // 24-bit color (throws std::runtime_error if palette is full)
+            static Color rgb(std::uint8_t red, std::uint8_t green, std::uint8_t blue);
+
+            static void setTruecolor(bool enabled);
+            static bool isTruecolor();
+    };
+
+    // Helper function to retrieve the corresponding escape code for the colors
+    const char* get_foreground_escape_code(Color color);
+    const char* get_background_escape_code(Color color);
+}
+
+#endif //PALETTE_H
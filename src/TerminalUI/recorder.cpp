@@ -0,0 +1,157 @@
+#include "recorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "../Diagnostics/memory_accounting.h"
+
+namespace TerminalUI {
+    namespace {
+        // packed event: type, time, length (bytes follow)
+        constexpr std::size_t event_header_size = 1 + sizeof(std::int64_t) + sizeof(std::uint32_t);
+
+        // JSON string contents (output is UTF-8, bytes above ASCII are copied as they are)
+        void append_escaped(std::string& out, const std::string_view text) {
+            for (const char character : text) {
+                switch (character) {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(character) < 0x20 || character == 0x7f) {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character));
+                            out += escaped;
+                        } else { out += character; }
+                }
+            }
+        }
+    }
+
+    AsciicastRecorder::AsciicastRecorder(std::string path_, const Dimension dimensions, const bool frame_markers, const std::size_t buffer_limit) :
+        path(std::move(path_)), file(path, std::ios::binary | std::ios::trunc), frame_markers(frame_markers), buffer_limit(buffer_limit) {
+        if (!file) { throw std::runtime_error("Can't create recording " + path); }
+
+        std::string header = "{\"version\": 2, \"width\": " + std::to_string(dimensions.width) + ", \"height\": " + std::to_string(dimensions.height)
+            + ", \"timestamp\": " + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        if (const char* term = std::getenv("TERM"); term != nullptr) {
+            header += ", \"env\": {\"TERM\": \"";
+            append_escaped(header, term);
+            header += "\"}";
+        }
+        header += "}\n";
+        file << header;
+        if (!file.flush()) { throw std::runtime_error("Can't write recording " + path); }
+
+        thread = std::thread(&AsciicastRecorder::work, this);
+    }
+
+    void AsciicastRecorder::output(const std::string_view bytes) { queue('o', bytes); }
+
+    void AsciicastRecorder::frame(const std::size_t bytes) {
+        if (!frame_markers) { return; }
+        char marker[64];
+        const int length = std::snprintf(marker, sizeof(marker), "frame %llu %zu", static_cast<unsigned long long>(++frame_count), bytes);
+        queue('m', std::string_view(marker, std::max(length, 0)));
+    }
+
+    void AsciicastRecorder::resize(const Dimension dimensions) {
+        char size[32];
+        const int length = std::snprintf(size, sizeof(size), "%ux%u", dimensions.width, dimensions.height);
+        queue('r', std::string_view(size, std::max(length, 0)));
+    }
+
+    std::size_t AsciicastRecorder::close() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (thread.joinable()) { thread.join(); }
+        if (file.is_open()) { file.close(); }
+        return total_dropped_bytes;
+    }
+
+    AsciicastRecorder::~AsciicastRecorder() {
+        close();
+    }
+
+    // Private:
+    void AsciicastRecorder::queue(const char type, const std::string_view data) {
+        const std::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) { return; }
+            // writer is behind (slow disk), frame isn't held up by it, recording just gets a gap
+            if (queued.size() + event_header_size + data.size() > buffer_limit) {
+                if (type == 'o') {
+                    dropped_bytes += data.size();
+                    total_dropped_bytes += data.size();
+                }
+                return;
+            }
+            const auto append_event = [this, time](const char event_type, const std::string_view event_data) {
+                const auto length = static_cast<std::uint32_t>(event_data.size());
+                char header[event_header_size];
+                header[0] = event_type;
+                std::memcpy(header + 1, &time, sizeof(time));
+                std::memcpy(header + 1 + sizeof(time), &length, sizeof(length));
+                queued.append(header, sizeof(header));
+                queued.append(event_data);
+            };
+            if (dropped_bytes > 0) {
+                char marker[64];
+                const int length = std::snprintf(marker, sizeof(marker), "dropped %zu bytes", dropped_bytes);
+                append_event('m', std::string_view(marker, std::max(length, 0)));
+                dropped_bytes = 0;
+            }
+            append_event(type, data);
+        }
+        wake.notify_one();
+    }
+
+    void AsciicastRecorder::work() {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::TERMINAL);
+        std::string events, line;
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return stopping || !queued.empty(); });
+            if (queued.empty()) { return; }
+            // events written meanwhile go to the other buffer
+            events.swap(queued);
+            lock.unlock();
+
+            writeEvents(events, line);
+            events.clear();
+            file.flush();
+
+            lock.lock();
+        }
+    }
+
+    void AsciicastRecorder::writeEvents(const std::string_view events, std::string& line) {
+        std::size_t offset = 0;
+        while (offset + event_header_size <= events.size()) {
+            const char type = events[offset];
+            std::int64_t time;
+            std::uint32_t length;
+            std::memcpy(&time, events.data() + offset + 1, sizeof(time));
+            std::memcpy(&length, events.data() + offset + 1 + sizeof(time), sizeof(length));
+            const std::string_view data = events.substr(offset + event_header_size, length);
+            offset += event_header_size + length;
+
+            char prefix[48];
+            const int prefix_length = std::snprintf(prefix, sizeof(prefix), "[%lld.%06lld, \"%c\", \"",
+                static_cast<long long>(time / 1000000000), static_cast<long long>(time % 1000000000 / 1000), type);
+            line.assign(prefix, std::max(prefix_length, 0));
+            append_escaped(line, data);
+            line += "\"]\n";
+            file.write(line.data(), static_cast<std::streamsize>(line.size()));
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "terminal.h"
+#include "timeline.h"
+
+namespace TerminalUI {
+    /*
+     *  Records output of terminal into asciicast v2 file (header line, then one JSON event per line, time in seconds from start).
+     *  Render loop only copies bytes into a bounded buffer under a short lock, formatting and writing to file happen on
+     *  recorder's own thread, so recording never waits for disk. If the buffer is full, bytes are dropped (recording
+     *  gets a marker saying how many) rather than stalling the frame.
+     *
+     *  With frame markers every drawn frame ends with marker event ("frame <n> <bytes>"), so output of each frame
+     *  can be cut out of recording byte-exactly (for comparing output of two builds).
+     */
+    class AsciicastRecorder {
+        std::string path;
+        std::ofstream file;
+        bool frame_markers;
+        std::size_t buffer_limit;
+        Clock::time_point start = Clock::now();
+        std::uint64_t frame_count = 0;
+
+        /*
+         *  Events waiting for writer thread, packed as: type, time (nanoseconds from start), length, bytes.
+         *  Writer swaps it with its own buffer, so both keep their capacity and steady recording doesn't allocate.
+         */
+        std::mutex mutex{};
+        std::condition_variable wake{};
+        std::string queued{};
+        std::size_t dropped_bytes = 0;
+        std::size_t total_dropped_bytes = 0;
+        bool stopping = false;
+        std::thread thread;
+
+        // type is asciicast event code ('o' output, 'r' resize, 'm' marker)
+        void queue(char type, std::string_view data);
+        void work();
+        // JSON lines of packed events
+        void writeEvents(std::string_view events, std::string& line);
+
+        public:
+            /*
+             *  Creates (or overwrites) recording with header for terminal of given size, throws std::runtime_error if file
+             *  can't be opened. Buffer limit is in bytes of output waiting for writer thread.
+             */
+            AsciicastRecorder(std::string path, Dimension dimensions, bool frame_markers = false, std::size_t buffer_limit = 4 << 20);
+
+            AsciicastRecorder(const AsciicastRecorder&) = delete;
+            AsciicastRecorder& operator=(const AsciicastRecorder&) = delete;
+
+            // bytes written to terminal
+            void output(std::string_view bytes);
+            // end of drawn frame (recorded only with frame markers)
+            void frame(std::size_t bytes);
+            void resize(Dimension dimensions);
+
+            [[nodiscard]] const std::string& filePath() const { return path; }
+            // writes out buffer and stops writer thread, returns how many bytes were dropped because buffer was full
+            std::size_t close();
+
+            ~AsciicastRecorder();
+    };
+}
+
+#endif //RECORDER_H
@@ -1,79 +1,191 @@
 #include "renderer.h"
+#include "../Diagnostics/memory_accounting.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 
 
 namespace TerminalUI {
-    Renderer::Renderer(std::optional<Dimension> dimensions) : Terminal(dimensions.value_or(get_terminal_dimensions())) {
-        setupNonBlockingInput(); // for handling keyboard interrupts (TODO: not really needed for all Renderers, make it optional)
+    Renderer::Renderer(std::optional<Dimension> dimensions, OutputSink* sink) : Terminal(dimensions.has_value() ? dimensions.value() : get_terminal_dimensions(), sink), owns_terminal(sink == nullptr) {
+        if (owns_terminal) {
+            setupNonBlockingInput(); // for handling keyboard interrupts (TODO: not really needed for all Renderers, make it optional)
+            detectCapabilities();
+            /*
+             *  Frames are held back instead of blocking on slow terminal (ssh), so input is handled right away.
+             *  On a terminal stdin usually shares open file with stdout, so it gets non-blocking too (readInput() expects that).
+             */
+            FileDescriptorSink::standardOutput().setNonBlocking(true);
+        }
     }
 
-    [[noreturn]] void Renderer::render(bool showFrameRate, std::optional<unsigned int> frameRate) {
-        std::optional<std::string> fps_str;
+    void Renderer::render(bool showFrameRate, std::optional<unsigned int> frameRate) {
+        // frame rate caps only animations now, frames caused by input are rendered right away
+        if (frameRate.has_value() && frameRate.value() > 0) {
+            base_frame_interval = std::chrono::microseconds(1000000 / frameRate.value());
+            animation_timeline.setFrameInterval(base_frame_interval);
+        }
+        show_frame_rate = showFrameRate;
+
+        // keys pressed before the loop started (for example while terminal was probed)
+        feedInput({});
+
+        char input[64];
         // main render loop
-        while (true) {
-            std::chrono::high_resolution_clock::time_point frame_render_start_timestamp;
-            if (showFrameRate || frameRate.has_value()) {
-                frame_render_start_timestamp = std::chrono::high_resolution_clock::now();
+        while (!stopped) {
+            // handle all pending keyboard interrupts before rendering, so fast typing doesn't queue up frames
+            while (isInputAvailable()) {
+                const std::optional<std::size_t> length = readInput(input, sizeof(input));
+                // stdin was closed, nobody can interact with app anymore
+                if (!length.has_value()) { stop(); break; }
+                // select() can report input that is already gone (non-blocking read finds nothing)
+                if (length.value() == 0) { break; }
+                feedInput(std::string_view(input, length.value()));
             }
 
-            // handle keyboard interrupts
-            if (isInputAvailable()) {
-                handleKeyboardInterrupts(readInput());
-            }
+            const std::optional<Clock::time_point> deadline = tick(Clock::now());
 
-            // set pixels from specific renderer, and draw them on screen
-            setFrame();
-
-            // print frame rate from previous calculation
-            if (showFrameRate && fps_str.has_value()) {
-                for (unsigned int i = 0; i < fps_str.value().length(); ++i) {
-                    setPixel(TerminalUI::Pixel{
-                                 TerminalUI::Color::BLACK,
-                                 TerminalUI::Color::WHITE,
-                                 fps_str.value()[i]
-                             }, TerminalUI::Position{0, i});
-                }
-            }
+            // sleep until input arrives or next animation frame is due (without animations, just wait for input)
+            if (!stopped) { waitForInput(deadline, FileDescriptorSink::standardOutput().unwrittenBytes() > 0); }
+        }
+    }
 
-            // draw pixels on the screen
-            draw();
-
-            // artificially slow down rendering to wanted framerate (TODO: not really working, fix needed)
-            if (frameRate.has_value()) {
-                const auto frame_render_end_timestamp = std::chrono::high_resolution_clock::now();
-                const auto current_frame_render_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                    frame_render_start_timestamp - frame_render_end_timestamp);
-
-                // check if frame rate is not set too high (so basically there is no purpose in slowing it down more)
-                if (current_frame_render_time.count() <= 1000000000 * frameRate.value() * 60) {
-                    // if not slow it down (with real elapse time subtraction)
-                    std::this_thread::sleep_for(
-                        std::chrono::nanoseconds(
-                            1000000000 / frameRate.value() * 60 - current_frame_render_time.count()));
-                }
-            }
+    void Renderer::feedInput(const std::string_view bytes) {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::RENDERER);
+        key_decoder.feed(bytes);
+        while (const std::optional<int> key = key_decoder.next()) {
+            handleKeyboardInterrupts(key.value());
+            frame_requested = true;
+        }
+    }
 
-            // displaying frame rate in left top corner (black on white)
-            if (showFrameRate) {
-                const auto frame_render_end_timestamp = std::chrono::high_resolution_clock::now();
-                const auto current_frame_render_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                    frame_render_end_timestamp - frame_render_start_timestamp);
+    std::optional<Clock::time_point> Renderer::tick(const Clock::time_point now) {
+        // finished animations can change app state (and their callbacks can start new animations)
+        if (animation_timeline.advance(now)) {
+            frame_requested = true;
+        }
 
-                // calculate how many this(current) frames could be display in second
-                const unsigned long int fps = 60 * 1000000000ULL / current_frame_render_time.count();
+        // output left from previous frames goes first
+        flushPendingOutput();
+        updateThroughput(now);
 
+        // render new frame only when something could have changed on the screen
+        if (!stopped && (frame_requested || animation_timeline.isAnimating())) {
+            const Clock::duration frame_interval = animation_timeline.frameInterval();
+            if (pendingOutput() > 0) {
                 /*
-                 *  Add an FPS counter to the next frame. By doing this, we ensure that the actual time taken to render a frame is accurately measured.
-                 *  This avoids not including the time spent rendering the FPS counter itself, which would otherwise create a delay between two frames
-                 *  that is not accounted for in the calculation.
+                 *  Output is behind: frame is composed (app keeps its state in step with input), but it isn't drawn,
+                 *  latest one is diffed and drawn once output catches up. Every frame slot that passes like this is a dropped frame,
+                 *  and animations slow down.
                  */
-                fps_str = "FPS: " + std::to_string(fps);
+                setFrame();
+                if (now - last_frame_timestamp >= frame_interval) {
+                    output_stats.dropped_frames++;
+                    last_frame_timestamp = now;
+                    animation_timeline.setFrameInterval(std::min(frame_interval * 2, base_frame_interval * 8));
+                }
+            } else {
+                frame_requested = false;
+                last_frame_timestamp = now;
+                renderFrame();
+                if (pendingOutput() == 0 && frame_interval > base_frame_interval) {
+                    animation_timeline.setFrameInterval(std::max(frame_interval / 2, base_frame_interval));
+                }
             }
         }
+
+        if (stopped) { return std::nullopt; }
+        std::optional<Clock::time_point> deadline = animation_timeline.nextDeadline(last_frame_timestamp);
+        // held frame is tried again in next frame slot (render loop wakes up sooner if output takes pending bytes)
+        if (frame_requested && pendingOutput() > 0) {
+            const Clock::time_point retry = last_frame_timestamp + animation_timeline.frameInterval();
+            deadline = deadline.has_value() ? std::min(deadline.value(), retry) : retry;
+        }
+        return deadline;
     }
 
-    Renderer::~Renderer() = default;
+    OutputStats Renderer::outputStats() const {
+        OutputStats stats = output_stats;
+        stats.pending_bytes = pendingOutput();
+        stats.frame_interval = animation_timeline.frameInterval();
+        return stats;
+    }
+
+    Renderer::~Renderer() {
+        if (owns_terminal) {
+            // rest of output is written (blocking), terminal is restored after it
+            FileDescriptorSink::standardOutput().setNonBlocking(false);
+            restoreInputSettings();
+        }
+    }
 
     // Private:
+    void Renderer::renderFrame() {
+        const auto frame_render_start_timestamp = Clock::now();
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::RENDERER);
+        #ifdef WORDLY_MEMORY_ACCOUNTING
+            const Diagnostics::AllocationSnapshot allocations_before = Diagnostics::allocationSnapshot();
+        #endif
+
+        // set pixels from specific renderer, and draw them on screen
+        setFrame();
+        // app could have quit during this frame
+        if (stopped) { return; }
+
+        // print frame rate from previous calculation
+        if (show_frame_rate && fps_text_length > 0) {
+            drawFrameRate(std::string_view(fps_text, fps_text_length));
+        }
+
+        // draw pixels on the screen
+        draw();
+        #ifdef WORDLY_MEMORY_ACCOUNTING
+            const Diagnostics::FrameAllocations frame_allocations = Diagnostics::recordFrame(allocations_before);
+        #endif
+
+        // displaying frame rate in left top corner (black on white)
+        if (show_frame_rate) {
+            const auto current_frame_render_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - frame_render_start_timestamp);
+
+            // calculate how many this(current) frames could be display in second
+            const unsigned long int fps = 60 * 1000000000ULL / std::max<std::int64_t>(current_frame_render_time.count(), 1);
+
+            /*
+             *  Add an FPS counter to the next frame. By doing this, we ensure that the actual time taken to render a frame is accurately measured.
+             *  This avoids not including the time spent rendering the FPS counter itself, which would otherwise create a delay between two frames
+             *  that is not accounted for in the calculation.
+             */
+            // bytes of this frame and how many of them cursor planner saved
+            const FrameOutput frame_output = lastFrameOutput();
+            fps_text_length = 0;
+            const auto append = [this](const int length) {
+                fps_text_length = std::min<std::size_t>(fps_text_length + std::max(length, 0), sizeof(fps_text) - 1);
+            };
+            append(std::snprintf(fps_text, sizeof(fps_text), "FPS: %lu | bytes: %zu (saved %zu) | out: %zu KiB/s, dropped %zu",
+                fps, frame_output.bytes_written, frame_output.cursor_bytes_saved, output_stats.bytes_per_second / 1024, output_stats.dropped_frames));
+            #ifdef WORDLY_MEMORY_ACCOUNTING
+                // row storage growth of renderer (arenas and row vectors), it's zero once they have grown to the size of a frame
+                append(std::snprintf(fps_text + fps_text_length, sizeof(fps_text) - fps_text_length, " | frame allocations: %zu", frameHeapAllocations()));
+                // all heap allocations of the frame (and who made most of them), heap in use and peak RSS
+                const std::string_view top_subsystem = Diagnostics::subsystem_names[static_cast<std::size_t>(frame_allocations.top_subsystem)];
+                append(std::snprintf(fps_text + fps_text_length, sizeof(fps_text) - fps_text_length, " | heap: %zu allocs%s%.*s%s, %zu KiB live, RSS %zu KiB",
+                    frame_allocations.allocations, frame_allocations.allocations > 0 ? " (" : "",
+                    frame_allocations.allocations > 0 ? static_cast<int>(top_subsystem.size()) : 0, top_subsystem.data(),
+                    frame_allocations.allocations > 0 ? ")" : "", Diagnostics::liveBytes() / 1024, Diagnostics::peakResidentBytes() / 1024));
+            #endif
+        }
+    }
+
+    void Renderer::updateThroughput(const Clock::time_point now) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - throughput_window_start);
+        if (elapsed < std::chrono::seconds(1)) { return; }
+        const std::size_t delivered = deliveredOutput();
+        output_stats.bytes_per_second = delivered >= throughput_bytes ? (delivered - throughput_bytes) * 1000000 / elapsed.count() : 0;
+        throughput_bytes = delivered;
+        throughput_window_start = now;
+    }
+
     void Renderer::setupNonBlockingInput() {
         #ifndef _WIN32
                 tcgetattr(STDIN_FILENO, &originalSettings);  // Save original terminal settings
@@ -85,6 +197,21 @@ namespace TerminalUI {
                 setbuf(stdout, NULL);  // Disable stdout buffering
         #endif
     }
+    void Renderer::detectCapabilities() {
+        #ifndef _WIN32
+            std::string pressed_keys;
+            bool replies_pending = false;
+            if (const std::optional<Capabilities> detected = CapabilityProbe::detect(STDIN_FILENO, STDOUT_FILENO, pressed_keys, replies_pending)) {
+                // truecolor is only turned on ($COLORTERM could have enabled it already)
+                if (detected.value().truecolor) { Palette::setTruecolor(true); }
+                setCapabilities(detected.value());
+            }
+            // slow terminal (ssh) can still answer, its replies (for a few seconds) mustn't be typed into the game
+            if (replies_pending) { key_decoder.dropProbeReplies(Clock::now() + std::chrono::seconds(5)); }
+            // keys pressed while probing are handled with the first input
+            key_decoder.feed(pressed_keys);
+        #endif
+    }
     void Renderer::restoreInputSettings() const {
         #ifndef _WIN32
             tcsetattr(STDIN_FILENO, TCSANOW, &originalSettings);  // Restore terminal settings
@@ -98,8 +225,41 @@ namespace TerminalUI {
     // Default implementation of setFrame(TODO: create default impl of setFrame() for renderers)
     void Renderer::setFrame() {}
     // Default implementation of handleKeyboardInterrupts(TODO: create default impl of handleKeyboardInterrupts() for renderers)
-    void Renderer::handleKeyboardInterrupts(int input) {}
+    void Renderer::handleKeyboardInterrupts(int) {}
+    void Renderer::drawFrameRate(const std::string_view text) {
+        for (unsigned int i = 0; i < text.length() && i < dimensions.width; ++i) {
+            setPixel(TerminalUI::Pixel{
+                         TerminalUI::Color::BLACK,
+                         TerminalUI::Color::WHITE,
+                         text[i]
+                     }, TerminalUI::Position{0, i});
+        }
+    }
 
+    void Renderer::waitForInput(const std::optional<Clock::time_point> deadline, const bool wake_on_output) {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(STDIN_FILENO, &readfds);
+        fd_set writefds;
+        FD_ZERO(&writefds);
+        if (wake_on_output) { FD_SET(STDOUT_FILENO, &writefds); }
+        const int descriptors = std::max(STDIN_FILENO, STDOUT_FILENO) + 1;
+
+        if (!deadline.has_value()) {
+            select(descriptors, &readfds, &writefds, NULL, NULL);
+            return;
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline.value() - Clock::now());
+        if (remaining.count() <= 0) {
+            return;
+        }
+        struct timeval timeout = {
+            static_cast<time_t>(remaining.count() / 1000000),
+            static_cast<suseconds_t>(remaining.count() % 1000000)
+        };
+        select(descriptors, &readfds, &writefds, NULL, &timeout);
+    }
     bool Renderer::isInputAvailable() {
         fd_set readfds;
         FD_ZERO(&readfds);
@@ -110,11 +270,14 @@ namespace TerminalUI {
 
         return (retval > 0 && FD_ISSET(STDIN_FILENO, &readfds));
     }
-    int Renderer::readInput() {
-        int c;
-        if (read(STDIN_FILENO, &c, 4) > 0) {
-            return c;
+    std::optional<std::size_t> Renderer::readInput(char* bytes, const std::size_t size) {
+        while (true) {
+            const ssize_t length = read(STDIN_FILENO, bytes, size);
+            if (length > 0) { return static_cast<std::size_t>(length); }
+            if (length == -1 && errno == EINTR) { continue; }
+            // nothing to read right now (stdin is non-blocking together with stdout)
+            if (length == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) { return 0; }
+            return std::nullopt;
         }
-        return -1;
     }
 }
@@ -2,12 +2,14 @@
 #define COMPONENT_H
 #include <optional>
 #include <string>
-#include <thread>
+#include <string_view>
 #include <unistd.h>
 #include <chrono>
 #include <sys/fcntl.h>
 
+#include "key_decoder.h"
 #include "terminal.h"
+#include "timeline.h"
 
 // Platform-specific includes
 #ifdef _WIN32
@@ -17,36 +19,108 @@
 #endif
 
 namespace TerminalUI {
+    // how output keeps up with frames (slow links)
+    struct OutputStats {
+        // delivered to output, measured over about a second
+        std::size_t bytes_per_second = 0;
+        // bytes output didn't take yet
+        std::size_t pending_bytes = 0;
+        // frame slots skipped because output was behind (screen jumps straight to the latest frame)
+        std::size_t dropped_frames = 0;
+        // current interval of animation frames (longer than requested while output is behind)
+        Clock::duration frame_interval{};
+    };
+
     class Renderer : public Terminal {
         // Platform-specific setup for non-blocking input
         void setupNonBlockingInput();
 
         // Restore terminal settings (POSIX only)
         void restoreInputSettings() const;
+        // asks terminal what it supports (or loads it from cache), needs input in non-canonical mode
+        void detectCapabilities();
 
         // Member variable to store original terminal settings (POSIX)
         #ifndef _WIN32
             termios originalSettings{};
         #endif
 
+        // renderer bound to its own sink (for example network session) doesn't own process terminal (and its stdin)
+        bool owns_terminal;
+        bool stopped = false;
+
+        Timeline animation_timeline{};
+        // set when frame has to be rendered even without input or running animation
+        bool frame_requested = true;
+        Clock::time_point last_frame_timestamp = Clock::now();
+        KeyDecoder key_decoder{};
+
+        /*
+         *  Frames aren't drawn while output is behind (sink has pending bytes), they're dropped instead,
+         *  and animation frame interval is doubled for every dropped frame (up to 8 times the requested one).
+         *  Every frame that goes out whole halves it again, so animations speed up once the link catches up.
+         */
+        Clock::duration base_frame_interval = animation_timeline.frameInterval();
+        OutputStats output_stats{};
+        // delivered bytes at start of throughput window
+        std::size_t throughput_bytes = 0;
+        Clock::time_point throughput_window_start = Clock::now();
+        void updateThroughput(Clock::time_point now);
+
+        // frame rate text is formatted into fixed buffer, so it doesn't allocate every frame
+        bool show_frame_rate = false;
+        char fps_text[192]{};
+        std::size_t fps_text_length = 0;
+
+        void renderFrame();
+
         protected:
             // main logic of Renderer class, sets pixel in Terminal renderer pixel array
             virtual void setFrame();
             virtual void handleKeyboardInterrupts(int input);
+            // draws frame rate text onto frame (default implementation writes it directly into left top corner)
+            virtual void drawFrameRate(std::string_view text);
+            // heap allocations made by renderer during last frame (shown next to frame rate in WORDLY_MEMORY_ACCOUNTING build)
+            [[nodiscard]] virtual std::size_t frameHeapAllocations() const { return 0; }
 
             // Keyboard interrupts
             static bool isInputAvailable();
-            static int readInput();
+            // reads available input bytes (0 if there are none right now, nothing if input was closed)
+            static std::optional<std::size_t> readInput(char* bytes, std::size_t size);
+            // blocks until input is available, or deadline passes (waits for input only if there is no deadline), or stdout takes more bytes
+            static void waitForInput(std::optional<Clock::time_point> deadline, bool wake_on_output = false);
 
         public:
-            explicit Renderer(std::optional<Dimension> dimensions = std::nullopt);
+            /*
+             *  without sink renderer uses process terminal (stdout, and stdin in non-canonical mode),
+             *  with sink it only writes frames there (input is passed by feedInput(), and frames are produced by tick())
+             */
+            explicit Renderer(std::optional<Dimension> dimensions = std::nullopt, OutputSink* sink = nullptr);
+
+            // animations advanced by render loop, time based so they don't depend on how many frames are rendered
+            [[nodiscard]] Timeline& timeline() { return animation_timeline; }
+            // renders next frame even if there was no input, and nothing is animated
+            void requestFrame() { frame_requested = true; }
+            [[nodiscard]] OutputStats outputStats() const;
+
+            // decodes input bytes into keys and handles them (next tick renders frame)
+            void feedInput(std::string_view bytes);
+            /*
+             *  one step of render loop: advances animations, and renders frame if anything changed (and output isn't behind),
+             *  returns time when next step is needed (nothing if only input can change the screen, or renderer was stopped)
+             */
+            std::optional<Clock::time_point> tick(Clock::time_point now);
+            // ends render loop (after current step), for example when user quits the app
+            void stop() { stopped = true; }
+            [[nodiscard]] bool isStopped() const { return stopped; }
 
             /*
              *  default implementation of render method for most use cases,
-             *  uses internal drawFrame to set pixels for new Frame, and draws them on screen in infinite loop
-             *  also allows you to draw frame rate (for debugging purpose), or set specific frame rate (artificially)
+             *  uses internal drawFrame to set pixels for new Frame, and draws them on screen in loop (until stop() is called, or stdin is closed)
+             *  new frames are rendered only after input, requestFrame() or while something is animated (otherwise loop sleeps),
+             *  also allows you to draw frame rate (for debugging purpose), or cap frame rate of animations (60 by default)
              */
-            [[noreturn]] virtual void render(bool showFrameRate = false, std::optional<unsigned int> frameRate = std::nullopt);
+            virtual void render(bool showFrameRate = false, std::optional<unsigned int> frameRate = std::nullopt);
 
             ~Renderer() override;
     };
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "../row_renderer.hpp"
+
+// keys in QWERTY layout, one row of keyboard each
+static constexpr std::array<std::string_view, 3> keyboard_layout { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+
+/*
+ *  On-screen keyboard with every letter colored by its best known state.
+ *  State comes as three letter masks (bit 0 is 'a'), keys are rasterized once and again only when a mask changes,
+ *  drawing is just copying three prepared rows. Keys of letters that can't be typed next are dimmed.
+ */
+template<class T>
+class KeyboardComponent {
+    public:
+        struct Colors {
+            TerminalUI::Color text = TerminalUI::Color::WHITE;
+            TerminalUI::Color absent = TerminalUI::Color::BLACK;
+            TerminalUI::Color present = TerminalUI::Color::YELLOW;
+            TerminalUI::Color correct = TerminalUI::Color::GREEN;
+            // letter of key that can't be typed next
+            TerminalUI::Color unavailable = TerminalUI::Color::BLACK;
+        };
+
+    private:
+        TerminalUI::RowRenderer<T>* renderer;
+        TerminalUI::RowPosition keyboard_position{};
+        Colors colors{};
+
+        std::uint32_t absent = 0;
+        std::uint32_t present = 0;
+        std::uint32_t correct = 0;
+        std::uint32_t available = (1u << 26) - 1;
+        // keys are separated by one empty cell
+        std::array<std::vector<TerminalUI::Pixel>, keyboard_layout.size()> rows{};
+
+        void rasterize() {
+            for (std::size_t r = 0; r < keyboard_layout.size(); ++r) {
+                rows[r].assign(keyboard_layout[r].size() * 2 - 1, TerminalUI::Pixel{TerminalUI::Color::NONE, TerminalUI::Color::NONE, std::nullopt});
+                for (std::size_t k = 0; k < keyboard_layout[r].size(); ++k) {
+                    const char letter = keyboard_layout[r][k];
+                    const std::uint32_t bit = 1u << (letter - 'a');
+                    // letters without feedback yet stay uncolored
+                    TerminalUI::Pixel key{TerminalUI::Color::WHITE, TerminalUI::Color::NONE, letter};
+                    if (correct & bit) { key = {colors.text, colors.correct, letter}; }
+                    else if (present & bit) { key = {colors.text, colors.present, letter}; }
+                    else if (absent & bit) { key = {colors.text, colors.absent, letter}; }
+                    if (!(available & bit)) { key.foreground_color = colors.unavailable; }
+                    rows[r][k * 2] = key;
+                }
+            }
+        }
+
+    public:
+        explicit KeyboardComponent(TerminalUI::RowRenderer<T> *row_renderer, TerminalUI::RowPosition position, Colors colors = {}) {
+            renderer = row_renderer;
+            keyboard_position = position;
+            this->colors = colors;
+            rasterize();
+        }
+
+        // state of letters (correct wins over present, present over absent), keys are rasterized again only if it changed
+        void set_letters(const std::uint32_t absent_letters, const std::uint32_t present_letters, const std::uint32_t correct_letters) {
+            if (absent_letters == absent && present_letters == present && correct_letters == correct) { return; }
+            absent = absent_letters;
+            present = present_letters;
+            correct = correct_letters;
+            rasterize();
+        }
+
+        // letters that can be typed next (for example the ones some word continues with), all by default
+        void set_available(const std::uint32_t available_letters) {
+            if (available_letters == available) { return; }
+            available = available_letters;
+            rasterize();
+        }
+
+        [[nodiscard]] static constexpr unsigned int height() { return keyboard_layout.size(); }
+
+        void drawComponent() {
+            for (const std::vector<TerminalUI::Pixel>& row : rows) { renderer->addRow(row, keyboard_position); }
+        }
+};
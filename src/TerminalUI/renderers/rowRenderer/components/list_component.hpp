@@ -18,6 +18,8 @@ class ListComponent {
     TerminalUI::RowPosition list_position{};
 
     std::vector<std::vector<TerminalUI::Pixel>> list{};
+    // text of options (if list was set from strings)
+    std::vector<std::string> options{};
 
 
     public:
@@ -29,33 +31,30 @@ class ListComponent {
 
         void set_list(std::vector<std::vector<TerminalUI::Pixel>> list) {
             this->list = list;
+            options.clear();
         }
         void set_list(std::vector<std::string> list) {
-            for (int i = 0; i < list.size(); i++) {
-                std::vector<TerminalUI::Pixel> string_pixels;
-
-                for (int c = 0; c < list[i].size(); c++) {
-                    string_pixels.emplace_back(
-                        TerminalUI::Pixel {
-                        TerminalUI::Color::WHITE,
-                        TerminalUI::Color::NONE,
-                            list[i][c]
-                    });
-                }
-
-                this->list.emplace_back(string_pixels);
+            for (std::size_t i = 0; i < list.size(); i++) {
+                this->list.emplace_back(renderer->toPixels(list[i]));
             }
+            options.insert(options.end(), list.begin(), list.end());
         }
 
         void select_next() {
             if (is_selectable && selected_index < list.size() - 1) { selected_index++; }
         }
         [[nodiscard]] std::string get_current_option() const {
+            if (selected_index < options.size()) { return options[selected_index]; }
+
+            // list was set from pixels, so option is read back from them
             const std::vector<TerminalUI::Pixel> row = list[selected_index];
+            auto& glyphs = renderer->glyphTable();
 
             std::string selected_option;
-            for (int c = 0; c < row.size(); c++) {
-                selected_option += row[c].character.value();
+            for (std::size_t c = 0; c < row.size(); c++) {
+                if (row[c].character.has_value() && !row[c].character.is_wide_continuation()) {
+                    selected_option += glyphs.bytes(row[c].character);
+                }
             }
 
             return selected_option;
@@ -66,12 +65,11 @@ class ListComponent {
         }
 
         void drawComponent() {
-            for (int i = 0; i < list.size(); i++) {
-                std::vector<TerminalUI::Pixel> row = list[i];
+            for (std::size_t i = 0; i < list.size(); i++) {
+                const std::vector<TerminalUI::Pixel>& row = list[i];
 
                 // add prefix to current row, if list is selectable
                 if (is_selectable && selected_index == i) {
-                    row.insert(row.begin(), selected_prefix.begin(), selected_prefix.end());
                     // render but with left alignment
                     auto position_left = TerminalUI::RowPosition {
                         list_position.vertical_position,
@@ -79,7 +77,10 @@ class ListComponent {
                         TerminalUI::RowAlignment::LEFT
                     };
 
-                    renderer->addRow(row, position_left);
+                    // prefix and row are written straight into row storage (no temporary row)
+                    const auto prefixed_row = renderer->emplaceRow(selected_prefix.size() + row.size(), position_left);
+                    std::ranges::copy(selected_prefix, prefixed_row.begin());
+                    std::ranges::copy(row, prefixed_row.begin() + selected_prefix.size());
                 } else { renderer->addRow(row, list_position); }
             }
         }
@@ -0,0 +1,76 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace TerminalUI {
+    /*
+     *  Bump allocator for data that lives for exactly one frame (rows and their pixels).
+     *  Allocation is a pointer increment, and everything is released at once by reset().
+     *  When frame didn't fit in one block, blocks are merged into a single bigger one on reset(),
+     *  so after a few frames arena stops touching global heap at all (steady state = zero allocations).
+     */
+    class FrameArena {
+        struct Block {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t size;
+        };
+
+        std::vector<Block> blocks{};
+        std::size_t used = 0;           // bytes used in the last block
+        std::size_t frame_bytes = 0;    // bytes requested in current frame (including alignment)
+        std::size_t upstream_allocations = 0;
+
+        static constexpr std::size_t minimal_block_size = 16 * 1024;
+
+        void add_block(const std::size_t size) {
+            blocks.push_back(Block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+            used = 0;
+            upstream_allocations++;
+        }
+
+        public:
+            explicit FrameArena(const std::size_t initial_size = minimal_block_size) {
+                blocks.reserve(8);
+                add_block(initial_size);
+            }
+
+            // uninitialized storage for 'count' objects (only for types that don't need destructor)
+            template <typename T>
+            std::span<T> allocate(const std::size_t count) {
+                static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+                const std::size_t bytes = count * sizeof(T);
+
+                std::size_t offset = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+                if (offset + bytes > blocks.back().size) {
+                    add_block(std::max(bytes + alignof(T), blocks.back().size * 2));
+                    offset = 0;
+                }
+                frame_bytes += offset - used + bytes;
+                used = offset + bytes;
+                return {reinterpret_cast<T*>(blocks.back().memory.get() + offset), count};
+            }
+
+            // frees everything allocated since last reset
+            void reset() {
+                if (blocks.size() > 1) {
+                    // frame didn't fit, so next frames get one block big enough for all of it
+                    const std::size_t size = std::max(frame_bytes * 2, minimal_block_size);
+                    blocks.clear();
+                    add_block(size);
+                }
+                used = 0;
+                frame_bytes = 0;
+            }
+
+            // number of times arena had to ask global heap for memory (since creation)
+            [[nodiscard]] std::size_t upstreamAllocations() const { return upstream_allocations; }
+    };
+}
+
+#endif //FRAME_ARENA_H
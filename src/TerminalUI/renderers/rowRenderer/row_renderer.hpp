@@ -1,10 +1,15 @@
 #ifndef ROW_COMPONENT_H
 #define ROW_COMPONENT_H
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "../../renderer.h"
+#include "../../sprite.hpp"
+#include "frame_arena.hpp"
 
 namespace TerminalUI {
     enum class VerticalPosition {
@@ -24,80 +29,84 @@ namespace TerminalUI {
     };
 
     /*
-     *  Struct for positioning row onto terminal
-     *  for making it easier, it just supports handful predefined positions.
-     *  Because rows will be rendered top to bottom depending on insert order (in their positions containers),
-     *  overlap is possible, so be aware of that.
+     *  Layers are composed bottom to top (enum order), so overlay rows cover content rows, and content rows cover background rows.
+     *  Rows inside one layer are rendered top to bottom depending on insert order (in their positions containers),
+     *  so overlap between different positions of the same layer is still possible, be aware of that.
      */
+    enum class Layer {
+        BACKGROUND,  // static content (logo, borders, help footers), rows stay until layer is cleared
+        CONTENT,     // rows are cleared every frame (by clearRows())
+        OVERLAY      // popups, frame rate etc. (cleared every frame, like content)
+    };
+
+    // Struct for positioning row onto terminal, for making it easier, it just supports handful predefined positions.
     struct RowPosition {
         VerticalPosition vertical_position;
         HorizontalPosition horizontal_position;
         RowAlignment alignment;
     };
 
+    // Rectangle of cells (end is exclusive), used for tracking which part of the screen has to be composed again
+    struct Region {
+        unsigned int top = 0, left = 0, bottom = 0, right = 0;
+
+        [[nodiscard]] bool empty() const { return top >= bottom || left >= right; }
+        void include(const Region &other) {
+            if (other.empty()) { return; }
+            if (empty()) { *this = other; return; }
+            top = std::min(top, other.top);
+            left = std::min(left, other.left);
+            bottom = std::max(bottom, other.bottom);
+            right = std::max(right, other.right);
+        }
+    };
+
     /*
      *  This renderer simplify rendering onto terminal, instead of pixels you use rows
      *  with predefine position on screen, it makes it way easier to render simple text UI without
      *  the need for manually adding, removing pixels from screen. In a way its abstraction of pixel rendering.
      *  But it still allows you to insert a row of Pixels, and thanks for that you can insert multicolor
      *  characters or pixels anywhere on the screen.
-     *  But if you need more control you can allways call setPixel() method.
+     *  But if you need more control you can allways call setPixel() method (but cells of layers that changed will be composed over it).
      *  It also has component system that creates for you ready-to-use elements of UI, for example: list, frame etc... (for now just list)
+     *
+     *  Every layer is rasterized into its own plane only when its rows changed (rows are compared by hash, so re-adding
+     *  the same rows every frame costs nothing more), and only the region covered by changed layers is composed onto screen.
      */
     template <typename T>
     class RowRenderer : Renderer {
         // implementation of drawFrame() method for RowRenderer
         void setFrame() override {
+            const std::size_t allocations_before = allocationCount();
+
             // handle control flow
             executeAppControlFlow();
+            composeLayers();
 
-            // convert rows to pixels
-            for (const auto& [group, rows] : grouped_rows) {
-                if (rows.empty()) { continue; }
-                // Find the row with the biggest pixel count
-                unsigned int absolute_row_width;
-                auto widest_row_iter = max_element(rows.begin(), rows.end(),
-                    [](const auto& a, const auto& b) {
-                        return std::get<0>(a).size() < std::get<0>(b).size(); // Compare pixel vector sizes
-                    });
-
-                if (widest_row_iter != rows.end()) {
-                    const auto& pixels = std::get<0>(*widest_row_iter);
-                    absolute_row_width = pixels.size();
-                } else {
-                    // if you can't find the widest row just panic
-                    throw std::runtime_error("Can't find widest row, something go wrong!");
-                }
+            last_frame_allocations = allocationCount() - allocations_before;
+        }
 
-                for (int row_idx = 0; row_idx < rows.size(); ++row_idx) {
-                    const auto row = rows[row_idx];
-                    for (int pixel = 0; pixel < std::get<0>(row).size(); ++pixel) {
-                        // ReSharper disable once CppLocalVariableMightNotBeInitialized // it panics if can't find the widest row
-                        Position position = convertRowPosition(std::get<0>(row), std::get<1>(row), absolute_row_width, rows.size());
-
-                        // calculate offsets
-                        position.x += pixel;
-                        /*
-                         *  Rows with bottom vertical positions have different y-axis calculations,
-                         *  basically you still want top to bottom order depending on insert order,
-                         *  so 'container' needs to be offset from bottom with height of said 'container'
-                         */
-                        if (group.first == VerticalPosition::BOTTOM) {
-                            // BOTTOM position rows
-                            position.y -= rows.size() - row_idx;
-                        }
-                        else { position.y += row_idx; }
-
-                        setPixel(std::get<0>(row)[pixel], position);
-                    }
-                }
-            }
+        // frame rate goes to overlay layer, so it's cleaned up like any other row (and covers only its own cells)
+        void drawFrameRate(std::string_view text) override {
+            const Layer previous_layer = target_layer;
+            target_layer = Layer::OVERLAY;
+            addRow(text, Position{0, 0}, Color::BLACK, Color::WHITE);
+            target_layer = previous_layer;
+            composeLayers();
         }
 
-        static Position convertRowPosition(std::vector<Pixel> row, RowPosition position, unsigned int absolute_row_width, unsigned int virtual_container_height) { // NOLINT(*-convert-member-functions-to-static)
-            const Dimension terminal_dimensions = Terminal().dimensions;
+        // left top corner of row on the screen, signed because row wider (or group taller) than the screen starts before its edge
+        struct Origin {
+            int y = 0;
+            int x = 0;
+        };
+
+        [[nodiscard]] Origin convertRowPosition(const std::size_t row_size, RowPosition position, const unsigned int widest_row, const unsigned int container_height) const {
+            const int terminal_height = static_cast<int>(dimensions.height), terminal_width = static_cast<int>(dimensions.width);
+            const int row_width = static_cast<int>(row_size), absolute_row_width = static_cast<int>(widest_row);
+            const int virtual_container_height = static_cast<int>(container_height);
 
-            Position calculated_position;
+            Origin calculated_position;
 
             // calculate x-axis position
             switch (position.horizontal_position) {
@@ -105,10 +114,10 @@ namespace TerminalUI {
                     calculated_position.x = 0;
                     break;
                 case HorizontalPosition::CENTER:
-                    calculated_position.x = terminal_dimensions.width / 2;
+                    calculated_position.x = terminal_width / 2;
                     break;
                 case HorizontalPosition::RIGHT:
-                    calculated_position.x = terminal_dimensions.width;
+                    calculated_position.x = terminal_width;
                     break;
             }
             // calculate y-axis position
@@ -118,10 +127,10 @@ namespace TerminalUI {
                     calculated_position.y = 1;
                     break;
                 case VerticalPosition::MIDDLE:
-                    calculated_position.y = terminal_dimensions.height / 2 - virtual_container_height / 2;
+                    calculated_position.y = terminal_height / 2 - virtual_container_height / 2;
                     break;
                 case VerticalPosition::BOTTOM:
-                    calculated_position.y = terminal_dimensions.height;
+                    calculated_position.y = terminal_height;
                     break;
             }
             // calculate absolute (use case for this is to calculate alignment based on widest row) alignment
@@ -145,15 +154,15 @@ namespace TerminalUI {
                     switch (position.horizontal_position) {
                         case HorizontalPosition::LEFT:
                             // move right by (widest_row - current_row)/2
-                            calculated_position.x += (absolute_row_width - row.size()) / 2;
+                            calculated_position.x += (absolute_row_width - row_width) / 2;
                             break;
                         case HorizontalPosition::CENTER:
                             // move left by half of current row
-                            calculated_position.x -= row.size() / 2;
+                            calculated_position.x -= row_width / 2;
                             break;
                         case HorizontalPosition::RIGHT:
                             // move left by widest row - (widest_row - current_row) / 2
-                            calculated_position.x -= absolute_row_width - (absolute_row_width - row.size()) / 2;
+                            calculated_position.x -= absolute_row_width - (absolute_row_width - row_width) / 2;
                             break;
                     }
                     break;
@@ -161,15 +170,15 @@ namespace TerminalUI {
                    switch (position.horizontal_position) {
                         case HorizontalPosition::LEFT:
                             // move right by widest_row - current_row
-                            calculated_position.x += absolute_row_width - row.size();
+                            calculated_position.x += absolute_row_width - row_width;
                             break;
                         case HorizontalPosition::CENTER:
                             // move left by half of the widest_row - (widest_row - current_row)
-                            calculated_position.x -= absolute_row_width / 2 - (absolute_row_width - row.size());
+                            calculated_position.x -= absolute_row_width / 2 - (absolute_row_width - row_width);
                             break;
                         case HorizontalPosition::RIGHT:
                             // move left by the length of current row
-                            calculated_position.x -= row.size();
+                            calculated_position.x -= row_width;
                             break;
                     }
                     break;
@@ -182,14 +191,221 @@ namespace TerminalUI {
             executeAppInterrupts(input);
         }
 
-        // vector of rows that will be rendered (pixel array and position) [they are grouped by their position]
-        std::map<std::pair<VerticalPosition, HorizontalPosition>, std::vector<std::tuple<std::vector<Pixel>, RowPosition>>> grouped_rows{};
+        struct Row {
+            std::span<const Pixel> pixels;  // stored in layer arena
+            RowPosition position;
+            std::optional<Position> absolute_position; // rows with absolute position are placed exactly there (and aren't part of any group)
+        };
+
+        struct PlacedSprite {
+            SpriteView sprite;      // not copied, sprite has to outlive layer rows
+            RowPosition position;
+            std::optional<Position> absolute_position;
+        };
+
+        struct LayerState {
+            // rows grouped by their position ([vertical][horizontal]), vectors keep their capacity between frames
+            std::array<std::vector<Row>, 9> grouped_rows{};
+            std::vector<Row> absolute_rows{};
+            // sprites are rasterized after rows (in insert order)
+            std::vector<PlacedSprite> sprites{};
+            // storage for pixels of rows, released all at once when layer is cleared
+            FrameArena arena{};
+
+            // rasterized rows (width * height cells), cells outside of 'bounds' are always empty
+            std::vector<std::optional<Pixel>> plane{};
+            Region bounds{};
+            // hash of rows rasterized into plane, layer is rasterized again only if it changes
+            std::uint64_t rasterized_signature = 0;
+            std::size_t row_vector_allocations = 0;
+        };
+        std::array<LayerState, 3> layers{};
+        // layer that addRow() and emplaceRow() write to
+        Layer target_layer = Layer::CONTENT;
+
+        std::size_t last_frame_allocations = 0;
+
+        [[nodiscard]] std::size_t allocationCount() const {
+            std::size_t count = 0;
+            for (const auto& layer : layers) { count += layer.arena.upstreamAllocations() + layer.row_vector_allocations; }
+            return count;
+        }
+
+        LayerState& currentLayer() { return layers[static_cast<std::size_t>(target_layer)]; }
+
+        void pushRow(const std::span<const Pixel> pixels, const RowPosition position) {
+            LayerState& layer = currentLayer();
+            auto& rows = layer.grouped_rows[static_cast<std::size_t>(position.vertical_position) * 3 + static_cast<std::size_t>(position.horizontal_position)];
+            if (rows.size() == rows.capacity()) { layer.row_vector_allocations++; }
+            rows.push_back(Row{pixels, position, std::nullopt});
+        }
+        void pushRow(const std::span<const Pixel> pixels, const Position position) {
+            LayerState& layer = currentLayer();
+            if (layer.absolute_rows.size() == layer.absolute_rows.capacity()) { layer.row_vector_allocations++; }
+            layer.absolute_rows.push_back(Row{pixels, {}, position});
+        }
+
+        void pushSprite(const PlacedSprite& placed) {
+            LayerState& layer = currentLayer();
+            if (layer.sprites.size() == layer.sprites.capacity()) { layer.row_vector_allocations++; }
+            layer.sprites.push_back(placed);
+        }
+
+        void clearLayerRows(LayerState& layer) {
+            for (auto& rows : layer.grouped_rows) { rows.clear(); }
+            layer.absolute_rows.clear();
+            layer.sprites.clear();
+            layer.arena.reset();
+        }
+
+        // FNV-1a over everything that affects how layer looks
+        static std::uint64_t signature(const LayerState& layer) {
+            std::uint64_t hash = 14695981039346656037ULL;
+            const auto mix = [&hash](const void* data, const std::size_t size) {
+                const auto* bytes = static_cast<const unsigned char*>(data);
+                for (std::size_t i = 0; i < size; ++i) { hash = (hash ^ bytes[i]) * 1099511628211ULL; }
+            };
+            const auto mix_row = [&](const Row& row) {
+                const std::size_t width = row.pixels.size();
+                mix(&width, sizeof(width));
+                mix(&row.position, sizeof(row.position));
+                if (row.absolute_position.has_value()) { mix(&row.absolute_position.value(), sizeof(Position)); }
+                mix(row.pixels.data(), row.pixels.size_bytes());
+            };
+            for (std::size_t group = 0; group < layer.grouped_rows.size(); ++group) {
+                const std::size_t count = layer.grouped_rows[group].size();
+                mix(&count, sizeof(count));
+                for (const Row& row : layer.grouped_rows[group]) { mix_row(row); }
+            }
+            for (const Row& row : layer.absolute_rows) { mix_row(row); }
+            // sprites are immutable, so their cells aren't hashed (just which sprite is where)
+            for (const PlacedSprite& placed : layer.sprites) {
+                const SpriteView& sprite = placed.sprite;
+                mix(&sprite.cells, sizeof(sprite.cells));
+                const unsigned int shape[3] = {sprite.height, sprite.width, sprite.stride};
+                mix(shape, sizeof(shape));
+                mix(&placed.position, sizeof(placed.position));
+                if (placed.absolute_position.has_value()) { mix(&placed.absolute_position.value(), sizeof(Position)); }
+            }
+            return hash;
+        }
+
+        // writes visible part of one row into layer plane (clipped to the screen, like sprites), and extends layer bounds
+        void rasterizeRow(LayerState& layer, const Row& row, const Origin origin) {
+            if (origin.y < 0 || origin.y >= static_cast<int>(dimensions.height) || origin.x >= static_cast<int>(dimensions.width)) { return; }
+            const std::size_t left = origin.x < 0 ? static_cast<std::size_t>(-origin.x) : 0;
+            if (left >= row.pixels.size()) { return; }
+            const Position position{static_cast<unsigned int>(origin.y), origin.x < 0 ? 0u : static_cast<unsigned int>(origin.x)};
+            const unsigned int width = std::min<std::size_t>(row.pixels.size() - left, dimensions.width - position.x);
+
+            std::ranges::copy(row.pixels.subspan(left, width), layer.plane.begin() + position.y * dimensions.width + position.x);
+            layer.bounds.include(Region{position.y, position.x, position.y + 1, position.x + width});
+        }
+
+        // copies visible rows of sprite into layer plane, and extends layer bounds
+        void rasterizeSprite(LayerState& layer, const PlacedSprite& placed) {
+            int y = 0, x = 0;
+            if (placed.absolute_position.has_value()) {
+                y = static_cast<int>(placed.absolute_position.value().y);
+                x = static_cast<int>(placed.absolute_position.value().x);
+            }
+            else {
+                // sprite is one block, so only its position matters (alignment is for rows of different widths)
+                const int height = static_cast<int>(dimensions.height), width = static_cast<int>(dimensions.width);
+                const int sprite_height = static_cast<int>(placed.sprite.height), sprite_width = static_cast<int>(placed.sprite.width);
+                switch (placed.position.vertical_position) {
+                    case VerticalPosition::TOP: y = 1; break;
+                    case VerticalPosition::MIDDLE: y = height / 2 - sprite_height / 2; break;
+                    case VerticalPosition::BOTTOM: y = height - sprite_height; break;
+                }
+                switch (placed.position.horizontal_position) {
+                    case HorizontalPosition::LEFT: x = 0; break;
+                    case HorizontalPosition::CENTER: x = width / 2 - sprite_width / 2; break;
+                    case HorizontalPosition::RIGHT: x = width - sprite_width; break;
+                }
+            }
+
+            Position position;
+            const SpriteView visible = placed.sprite.clipped(y, x, dimensions, position);
+            if (visible.empty()) { return; }
+            for (unsigned int row = 0; row < visible.height; ++row) {
+                std::ranges::copy(visible.row(row), layer.plane.begin() + (position.y + row) * dimensions.width + position.x);
+            }
+            layer.bounds.include(Region{position.y, position.x, position.y + visible.height, position.x + visible.width});
+        }
+
+        // rasterizes layer again (if its rows changed), returns region of the screen that has to be composed again
+        Region rasterizeLayer(LayerState& layer) {
+            const std::uint64_t current_signature = signature(layer);
+            if (current_signature == layer.rasterized_signature && !layer.plane.empty()) { return {}; }
+            layer.rasterized_signature = current_signature;
+            if (layer.plane.empty()) { layer.plane.resize(dimensions.width * dimensions.height); }
+
+            // clear previous content
+            Region changed = layer.bounds;
+            for (unsigned int y = changed.top; y < changed.bottom; ++y) {
+                std::fill_n(layer.plane.begin() + y * dimensions.width + changed.left, changed.right - changed.left, std::nullopt);
+            }
+            layer.bounds = {};
+
+            // convert rows to pixels
+            for (std::size_t group = 0; group < layer.grouped_rows.size(); ++group) {
+                const auto& rows = layer.grouped_rows[group];
+                if (rows.empty()) { continue; }
+                const auto vertical_position = static_cast<VerticalPosition>(group / 3);
+
+                // Find the row with the biggest pixel count
+                const unsigned int absolute_row_width = std::ranges::max_element(rows, {}, [](const Row& row) { return row.pixels.size(); })->pixels.size();
+
+                for (std::size_t row_idx = 0; row_idx < rows.size(); ++row_idx) {
+                    const Row& row = rows[row_idx];
+                    Origin position = convertRowPosition(row.pixels.size(), row.position, absolute_row_width, rows.size());
+                    /*
+                     *  Rows with bottom vertical positions have different y-axis calculations,
+                     *  basically you still want top to bottom order depending on insert order,
+                     *  so 'container' needs to be offset from bottom with height of said 'container'
+                     */
+                    if (vertical_position == VerticalPosition::BOTTOM) {
+                        // BOTTOM position rows
+                        position.y -= static_cast<int>(rows.size() - row_idx);
+                    }
+                    else { position.y += static_cast<int>(row_idx); }
+
+                    rasterizeRow(layer, row, position);
+                }
+            }
+            for (const Row& row : layer.absolute_rows) {
+                const Position position = row.absolute_position.value();
+                rasterizeRow(layer, row, Origin{static_cast<int>(position.y), static_cast<int>(position.x)});
+            }
+            for (const PlacedSprite& placed : layer.sprites) { rasterizeSprite(layer, placed); }
+
+            changed.include(layer.bounds);
+            return changed;
+        }
+
+        // composes changed part of layers onto terminal pixels (top-most non-empty cell wins)
+        void composeLayers() {
+            Region changed;
+            for (auto& layer : layers) { changed.include(rasterizeLayer(layer)); }
+
+            for (unsigned int y = changed.top; y < changed.bottom; ++y) {
+                for (unsigned int x = changed.left; x < changed.right; ++x) {
+                    const std::size_t cell = y * dimensions.width + x;
+                    std::optional<Pixel> composed = std::nullopt;
+                    for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+                        if (!layer->plane.empty() && layer->plane[cell].has_value()) { composed = layer->plane[cell]; break; }
+                    }
+                    pixels[y][x] = composed;
+                }
+            }
+        }
 
         public:
             using AppControlFlowCallback = void (T::*)(RowRenderer*);
             using AppInterruptsCallback = void (T::*)(int);
 
-            RowRenderer(T* instance, AppControlFlowCallback appControlFlow, AppInterruptsCallback appInterrupts, std::optional<Dimension> dimensions = std::nullopt): Renderer(dimensions), instance_(instance), appControlFlow_(appControlFlow), appInterrupts_(appInterrupts) {
+            RowRenderer(T* instance, AppControlFlowCallback appControlFlow, AppInterruptsCallback appInterrupts, std::optional<Dimension> dimensions = std::nullopt, OutputSink* sink = nullptr): Renderer(dimensions, sink), instance_(instance), appControlFlow_(appControlFlow), appInterrupts_(appInterrupts) {
                 // Compile-time checks
                 static_assert(std::is_member_function_pointer<AppControlFlowCallback>::value,
                               "appControlFlow must be a member function pointer with the correct signature");
@@ -201,35 +417,118 @@ namespace TerminalUI {
             void setPixel(Pixel pixel, Position position) const override {
                 Renderer::setPixel(pixel, position);
             }
+            GlyphTable& glyphTable() {
+                return glyphs;
+            }
+            // size of the screen (for apps that fit their content to it)
+            [[nodiscard]] Dimension screenSize() const {
+                return dimensions;
+            }
+            // animations (and timers) for app, frames are rendered while any of them is running
+            using Renderer::timeline;
+            using Renderer::requestFrame;
+            // for driving renderer from outside of render() loop (for example by server with many sessions)
+            using Renderer::feedInput;
+            using Renderer::tick;
+            using Renderer::stop;
+            using Renderer::isStopped;
+            using Renderer::setDiffThreads;
+            using Renderer::outputStats;
+            // copies output into asciicast recording
+            using Renderer::setRecorder;
+
+            // layers are rasterized again for new size (their rows are kept)
+            void resize(const Dimension new_dimensions) override {
+                Renderer::resize(new_dimensions);
+                for (auto& layer : layers) {
+                    layer.plane.clear();
+                    layer.bounds = {};
+                }
+                requestFrame();
+            }
 
-            // multiple addRow() methods for more user-friendly row inserting
-            void addRow(std::string row, RowPosition position) { // NOLINT(*-convert-member-functions-to-static)
+            /*
+             *  Converts UTF-8 text into row of pixels (one pixel per cell, so wide characters take two pixels),
+             *  non-ASCII characters are interned in terminal glyph table.
+             */
+            std::vector<Pixel> toPixels(std::string_view text, Color foreground_color = Color::WHITE, Color background_color = Color::NONE) {
                 std::vector<Pixel> pixels;
-                pixels.resize(row.length());
-                for (int i = 0; i < row.length(); i++) {
-                    pixels[i] = Pixel {
-                        Color::WHITE,
-                        Color::NONE,
-                        row[i]
-                    };
+                pixels.reserve(text.size());
+                for (std::size_t i = 0; i < text.size();) {
+                    const char32_t code_point = decode_utf8(text, i);
+                    const Glyph glyph = glyphs.intern(code_point);
+                    pixels.push_back(Pixel { foreground_color, background_color, glyph });
+                    if (glyphs.width(glyph) == 2) {
+                        pixels.push_back(Pixel { foreground_color, background_color, Glyph::wideContinuation() });
+                    }
+                }
+                return pixels;
+            }
+
+            // selects layer for next addRow()/emplaceRow() calls (and components drawn after it)
+            void selectLayer(const Layer layer) { target_layer = layer; }
+
+            /*
+             *  Multiple addRow() methods for more user-friendly row inserting (rows go to selected layer).
+             *  Pixels are copied into layer arena, so nothing passed here has to outlive the call,
+             *  and rows don't allocate anything once arena and rows vectors have grown to the size of a frame.
+             *  Rows can be positioned with predefined positions, or placed at exact position.
+             */
+            template <typename Placement>
+            void addRow(std::string_view row, Placement position, Color foreground_color = Color::WHITE, Color background_color = Color::NONE) {
+                // one cell never takes more bytes than its UTF-8 sequence, so text length is enough for pixels
+                const auto storage = currentLayer().arena.template allocate<Pixel>(row.size());
+                std::size_t cells = 0;
+                for (std::size_t i = 0; i < row.size();) {
+                    const Glyph glyph = glyphs.intern(decode_utf8(row, i));
+                    storage[cells++] = Pixel { foreground_color, background_color, glyph };
+                    if (glyphs.width(glyph) == 2) {
+                        storage[cells++] = Pixel { foreground_color, background_color, Glyph::wideContinuation() };
+                    }
                 }
-                auto key = std::make_pair(position.vertical_position, position.horizontal_position);
-                grouped_rows[key].push_back(std::make_tuple(pixels, position));
+                pushRow(storage.first(cells), position);
+            }
+            template <typename Placement>
+            void addRow(std::span<const Pixel> pixels, Placement position) {
+                const auto storage = currentLayer().arena.template allocate<Pixel>(pixels.size());
+                std::ranges::copy(pixels, storage.begin());
+                pushRow(storage, position);
             }
-            void addRow(std::vector<Pixel> pixels, RowPosition position) { // NOLINT(*-convert-member-functions-to-static)
-                auto key = std::make_pair(position.vertical_position, position.horizontal_position);
-                grouped_rows[key].push_back(std::make_tuple(pixels, position));
+            // adds row of given width and returns its pixels to be filled in place (valid until its layer is cleared)
+            template <typename Placement>
+            std::span<Pixel> emplaceRow(std::size_t width, Placement position) {
+                const auto storage = currentLayer().arena.template allocate<Pixel>(width);
+                pushRow(storage, position);
+                return storage;
             }
 
+            /*
+             *  Places sprite into selected layer (like a row, but whole block at once, and without converting anything),
+             *  sprite isn't copied, so it has to outlive layer rows (static sprites do). Its cells aren't compared between frames,
+             *  so sprite must never change (buffers changed in place are added with addRow()).
+             */
+            void blit(const SpriteView sprite, const RowPosition position) { pushSprite(PlacedSprite{sprite, position, std::nullopt}); }
+            void blit(const SpriteView sprite, const Position position) { pushSprite(PlacedSprite{sprite, {}, position}); }
+
+            // clears rows of per-frame layers (content and overlay), background stays as it is
             void clearRows() {
-                grouped_rows.clear();
+                clearLayerRows(layers[static_cast<std::size_t>(Layer::CONTENT)]);
+                clearLayerRows(layers[static_cast<std::size_t>(Layer::OVERLAY)]);
+                target_layer = Layer::CONTENT;
             }
-            void clearScreen() { // NOLINT(*-convert-member-functions-to-static)
-                grouped_rows.clear();
-                clear();
+            void clearLayer(const Layer layer) {
+                clearLayerRows(layers[static_cast<std::size_t>(layer)]);
             }
+            // clears rows of all layers (including background)
+            void clearScreen() {
+                for (auto& layer : layers) { clearLayerRows(layer); }
+                target_layer = Layer::CONTENT;
+            }
+
+            // heap allocations made by rows storage during last frame (0 in steady state)
+            [[nodiscard]] std::size_t frameHeapAllocations() const override { return last_frame_allocations; }
 
-            [[noreturn]] void render(bool showFrameRate, std::optional<unsigned int> frameRate = std::nullopt) override {
+            void render(bool showFrameRate, std::optional<unsigned int> frameRate = std::nullopt) override {
                 Renderer::render(showFrameRate, frameRate);
             }
 
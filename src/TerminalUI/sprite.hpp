@@ -0,0 +1,100 @@
+#ifndef SPRITE_HPP
+#define SPRITE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+#include "terminal.h"
+
+namespace TerminalUI {
+    // colors of sprite cells (one sprite can use several of them, picked by mask)
+    struct SpriteStyle {
+        Color foreground_color = Color::WHITE;
+        Color background_color = Color::NONE;
+    };
+
+    /*
+     *  Non-owning view of rectangle of cells (rows are 'stride' cells apart, so view can be cropped without copying).
+     *  Rows are copied whole (cells aren't blended), so empty cells are copied too: in RowRenderer lower layers show through them
+     *  (rows of the sprite's own layer under them are cleared), Terminal::blit() clears screen cells under them.
+     */
+    struct SpriteView {
+        const std::optional<Pixel>* cells = nullptr;
+        unsigned int height = 0;
+        unsigned int width = 0;
+        unsigned int stride = 0;
+
+        [[nodiscard]] constexpr bool empty() const { return height == 0 || width == 0; }
+        [[nodiscard]] constexpr std::span<const std::optional<Pixel>> row(const unsigned int y) const {
+            return {cells + static_cast<std::size_t>(y) * stride, width};
+        }
+        // part of the view (clamped to its size)
+        [[nodiscard]] constexpr SpriteView cropped(const unsigned int top, const unsigned int left, const unsigned int rows, const unsigned int columns) const {
+            if (top >= height || left >= width) { return {}; }
+            return {cells + static_cast<std::size_t>(top) * stride + left, std::min(rows, height - top), std::min(columns, width - left), stride};
+        }
+        /*
+         *  Part of the view that is visible when its left top corner is placed at (y, x) on area of given size
+         *  (position can be negative, or out of the area), 'position' is set to where visible part starts.
+         */
+        [[nodiscard]] constexpr SpriteView clipped(const int y, const int x, const Dimension area, Position& position) const {
+            const unsigned int top = y < 0 ? -y : 0, left = x < 0 ? -x : 0;
+            position = Position{y < 0 ? 0u : static_cast<unsigned int>(y), x < 0 ? 0u : static_cast<unsigned int>(x)};
+            if (position.y >= area.height || position.x >= area.width) { return {}; }
+            return cropped(top, left, area.height - position.y, area.width - position.x);
+        }
+    };
+
+    /*
+     *  Rectangle of pre-packed cells, meant to be built at compile time from ASCII art,
+     *  so drawing it is just copying its rows (no text decoding, nor layout).
+     */
+    template <unsigned int Height, unsigned int Width>
+    struct Sprite {
+        std::array<std::optional<Pixel>, Height * Width> cells{};
+
+        [[nodiscard]] constexpr SpriteView view() const { return SpriteView{cells.data(), Height, Width, Width}; }
+        constexpr operator SpriteView() const { return view(); } // NOLINT(*-explicit-constructor)
+
+        static constexpr unsigned int height = Height;
+        static constexpr unsigned int width = Width;
+    };
+
+    /*
+     *  Sprite from rows of ASCII art (for example raw string literals in 'char art[][width + 1]'),
+     *  style of every cell is picked by digit on the same place in 'mask' (anything else than digit is style 0).
+     *  Cells after end of shorter rows are empty. Non-ASCII characters would need glyph table of terminal,
+     *  so they aren't allowed (it's compile error when sprite is constexpr).
+     */
+    template <std::size_t Height, std::size_t Columns, std::size_t StyleCount>
+    constexpr Sprite<Height, Columns - 1> makeSprite(const char (&art)[Height][Columns], const char (&mask)[Height][Columns], const std::array<SpriteStyle, StyleCount>& styles) {
+        static_assert(StyleCount > 0, "Sprite needs at least one style");
+        Sprite<Height, Columns - 1> sprite;
+        for (std::size_t y = 0; y < Height; ++y) {
+            bool row_ended = false;
+            for (std::size_t x = 0; x + 1 < Columns; ++x) {
+                const char character = art[y][x];
+                row_ended = row_ended || character == '\0';
+                if (row_ended) { continue; }
+                if (static_cast<unsigned char>(character) >= 0x80) { throw std::runtime_error("Sprite art has to be ASCII!"); }
+
+                const char style_index = mask[y][x];
+                const SpriteStyle style = style_index >= '0' && style_index <= '9' && static_cast<std::size_t>(style_index - '0') < StyleCount
+                    ? styles[style_index - '0'] : styles[0];
+                sprite.cells[y * (Columns - 1) + x] = Pixel{style.foreground_color, style.background_color, character};
+            }
+        }
+        return sprite;
+    }
+    // every cell has the same style
+    template <std::size_t Height, std::size_t Columns>
+    constexpr Sprite<Height, Columns - 1> makeSprite(const char (&art)[Height][Columns], const SpriteStyle style = {}) {
+        return makeSprite(art, art, std::array<SpriteStyle, 1>{style});
+    }
+}
+
+#endif //SPRITE_HPP
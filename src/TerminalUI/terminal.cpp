@@ -1,26 +1,50 @@
 #include "terminal.h"
+#include "recorder.h"
+#include "sprite.hpp"
+#include "../Diagnostics/memory_accounting.h"
 
-#include <iostream>
-#include <ostream>
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
+#include <thread>
 #ifndef _WIN32
     #include <sys/ioctl.h>
 #endif
 #include <unistd.h>
 
 namespace TerminalUI {
-    Terminal::Terminal(const Dimension dimensions_) {
+    namespace {
+        // biggest shift (in rows) between two frames that is detected
+        constexpr int max_scroll_shift = 8;
+        // longest run of unchanged cells that cursor can skip by drawing them again
+        constexpr unsigned int max_overwritten_gap = 8;
+        // the most rows that cursor moves down with CR LF (instead of CUD)
+        constexpr unsigned int max_newline_moves = 4;
+        // frames smaller than this are diffed on one thread (about 250x160 cells)
+        constexpr unsigned int min_parallel_cells = 40000;
+        constexpr unsigned int min_band_height = 8;
+
+        // control sequence with one parameter (omitted when it's 1, which is default)
+        void append_sequence(std::string& out, const unsigned int parameter, const char command) {
+            out += "\033[";
+            if (parameter != 1) { out += std::to_string(parameter); }
+            out += command;
+        }
+        // absolute cursor move (CUP), parameters are 1-based and omitted when they are 1
+        void append_cursor_position(std::string& out, const Position position) {
+            out += "\033[";
+            if (position.y != 0 || position.x != 0) { out += std::to_string(position.y + 1); }
+            if (position.x != 0) { out += ';'; out += std::to_string(position.x + 1); }
+            out += 'H';
+        }
+    }
+
+    Terminal::Terminal(const Dimension dimensions_, OutputSink* sink_) : sink(sink_ != nullptr ? sink_ : &FileDescriptorSink::standardOutput()) {
         // Hide cursor
         hideCursor();
 
         dimensions = dimensions_;
-        // set array size depending on dimensions provided in constructor parameters (for both pixels and buffer)
-        pixels = new std::optional<Pixel>*[dimensions.height]; // set y-axis dimension
-        buffer = new std::optional<Pixel>*[dimensions.height]; // set y-axis dimension
-        for (int y = 0; y < dimensions.height; ++y) {
-            pixels[y] = new std::optional<Pixel>[dimensions.width]; // set x-axis dimension
-            buffer[y] = new std::optional<Pixel>[dimensions.width]; // set x-axis dimension
-        }
+        allocate();
     }
 
     void Terminal::setPixel(Pixel pixel, Position position) const {
@@ -28,104 +52,421 @@ namespace TerminalUI {
         pixels[position.y][position.x] = pixel;
     }
 
+    void Terminal::blit(const SpriteView& sprite, const Position position) const {
+        Position visible_position;
+        const SpriteView visible = sprite.clipped(static_cast<int>(position.y), static_cast<int>(position.x), dimensions, visible_position);
+        for (unsigned int y = 0; y < visible.height; ++y) {
+            std::ranges::copy(visible.row(y), pixels[visible_position.y + y] + visible_position.x);
+        }
+    }
+
     void Terminal::draw() const {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::TERMINAL);
         // check if first frame was drawn, if not draw it
         if (!first_frame_drawn)  { fresh_draw(); return; }
 
-        // find changes in new frame (compare pixels with buffer)
-        for (int y = 0; y < dimensions.height; ++y) {
-            for (int x = 0; x < dimensions.width; ++x) {
-                if (pixels[y][x] != buffer[y][x]) {
-                    // here we can just swap pixel for new one (and update buffer)
-                    buffer[y][x] = pixels[y][x];
+        writer.cursor_bytes_saved = 0;
+        const std::size_t frame_start = writer.output.size();
 
-                    // Save current cursor position
-                    std::cout << "\033[s";
-                    // move cursor to changed pixel
-                    std::cout << "\033[" << y << ";" << x + 1 << "H";
-                    // print pixel
-                    draw_pixel(pixels[y][x]);
-                    // Restore cursor position
-                    std::cout << "\033[u";
-                }
-            }
-        }
+        // move rows that only shifted, so diff below doesn't see them as changed
+        scroll_moved_rows();
+
+        // find changes in new frame (compare pixels with buffer), large frames are split into bands of rows diffed in parallel
+        const auto diff = [this](FrameWriter& band, const unsigned int begin, const unsigned int end) { diff_rows(band, begin, end); };
+        if (!run_in_bands(diff)) { diff(writer, 0, dimensions.height); }
+
+        synchronize_frame(frame_start);
+        last_frame_output = {writer.output.size(), writer.cursor_bytes_saved};
+        flush();
+        if (recorder != nullptr) { recorder->frame(last_frame_output.bytes_written); }
     }
 
     void Terminal::fresh_draw() const {
         // save frame to buffer (and set fresh draw flag to true)
         first_frame_drawn = true;
         // Deep copy of pixels to buffer
-        for (int y = 0; y < dimensions.height; ++y) {
-            for (int x = 0; x < dimensions.width; ++x) {
+        for (unsigned int y = 0; y < dimensions.height; ++y) {
+            for (unsigned int x = 0; x < dimensions.width; ++x) {
                 buffer[y][x] = pixels[y][x];
             }
+            buffer_row_hashes[y] = row_hash(buffer[y]);
         }
 
-        // Save initial cursor position
-        std::cout << "\033[s";
+        const std::size_t frame_start = writer.output.size();
+        // frame covers whole screen, starting in left top corner
+        writer.output += "\033[H";
+        const auto serialize = [this](FrameWriter& band, const unsigned int begin, const unsigned int end) { serialize_rows(band, begin, end); };
+        if (!run_in_bands(serialize)) { serialize(writer, 0, dimensions.height); }
 
-        for (int y = 0; y < dimensions.height; ++y) {
-            for (int x = 0; x < dimensions.width; ++x) {
-                draw_pixel(pixels[y][x]);
-            }
-            // when finish printing row (x-axis) go to next line
-            std::cout << std::endl;
-        }
+        // cursor waits in last column (terminals differ in what happens next), so its position is unknown
+        writer.cursor.reset();
+        synchronize_frame(frame_start);
+        last_frame_output = {writer.output.size(), 0};
+        flush();
+        if (recorder != nullptr) { recorder->frame(last_frame_output.bytes_written); }
     }
 
     void Terminal::clear() const {
-        // Restore cursor position (for clearing terminal)
-        std::cout << "\033[u";
-
         // fill all elements of 2-dimensional array with NullOpt
-        for (int y = 0; y < dimensions.height; ++y) {
-            for (int x = 0; x < dimensions.width; ++x) {
+        for (unsigned int y = 0; y < dimensions.height; ++y) {
+            for (unsigned int x = 0; x < dimensions.width; ++x) {
                 pixels[y][x] = std::nullopt;
             }
         }
     }
 
+    void Terminal::resize(const Dimension new_dimensions) {
+        deallocate();
+        dimensions = new_dimensions;
+        allocate();
+
+        if (recorder != nullptr) { recorder->resize(new_dimensions); }
+        // old frame doesn't match new size, so screen is cleared and drawn again
+        first_frame_drawn = false;
+        writer.output += "\033[H\033[2J";
+        writer.cursor.reset();
+        flush();
+    }
+
+    void Terminal::setCapabilities(const Capabilities detected) {
+        if (detected.bracketed_paste != capabilities.bracketed_paste) {
+            writer.output += detected.bracketed_paste ? "\033[?2004h" : "\033[?2004l";
+            flush();
+        }
+        capabilities = detected;
+    }
+
+    void Terminal::setRecorder(AsciicastRecorder* output_recorder) {
+        recorder = output_recorder;
+        if (recorder == nullptr) { return; }
+        // cursor was hidden when terminal was created
+        recorder->output(capabilities.bracketed_paste ? "\033[?25l\033[?2004h" : "\033[?25l");
+    }
+
     Terminal::~Terminal() {
+        // leave cursor on new line below the frame, so whatever comes after doesn't overwrite it
+        if (first_frame_drawn) {
+            append_cursor_position(writer.output, Position{dimensions.height - 1, 0});
+            writer.output += "\r\n";
+        }
+        if (capabilities.bracketed_paste) { writer.output += "\033[?2004l"; }
+        deallocate();
+
+        // Shows cursor
+        showCursor();
+    }
+
+
+    // Private:
+    void Terminal::allocate() {
+        const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::TERMINAL);
+        // set array size depending on dimensions (for both pixels and buffer)
+        pixels = new std::optional<Pixel>*[dimensions.height]; // set y-axis dimension
+        buffer = new std::optional<Pixel>*[dimensions.height]; // set y-axis dimension
+        for (unsigned int y = 0; y < dimensions.height; ++y) {
+            pixels[y] = new std::optional<Pixel>[dimensions.width]; // set x-axis dimension
+            buffer[y] = new std::optional<Pixel>[dimensions.width]; // set x-axis dimension
+        }
+        pixel_row_hashes.resize(dimensions.height);
+        buffer_row_hashes.resize(dimensions.height);
+    }
+    void Terminal::deallocate() {
         // Deallocate pixels array
-        for (int y = 0; y < dimensions.height; ++y) {
+        for (unsigned int y = 0; y < dimensions.height; ++y) {
             delete[] pixels[y]; // Delete each row (x-axis)
         }
         delete[] pixels; // Delete the outer array (y-axis)
 
         // Deallocate buffer array
-        for (int y = 0; y < dimensions.height; ++y) {
+        for (unsigned int y = 0; y < dimensions.height; ++y) {
             delete[] buffer[y]; // Delete each row (x-axis)
         }
         delete[] buffer; // Delete the outer array (y-axis)
+    }
+    void Terminal::flush() const {
+        if (writer.output.empty()) { return; }
+        bytes_sent += writer.output.size();
+        if (recorder != nullptr) { recorder->output(writer.output); }
+        sink->write(writer.output);
+        writer.output.clear();
+    }
 
-        // Shows cursor
-        showCursor();
+    std::uint64_t Terminal::row_hash(const std::optional<Pixel>* row) const {
+        // FNV-1a over cells (empty cell has its own value, so it differs from any pixel)
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (unsigned int x = 0; x < dimensions.width; ++x) {
+            const std::uint64_t cell = row[x].has_value() ? std::bit_cast<std::uint32_t>(row[x].value()) + 1ULL : 0;
+            hash = (hash ^ cell) * 1099511628211ULL;
+        }
+        return hash;
+    }
+    bool Terminal::rows_equal(const std::optional<Pixel>* first, const std::optional<Pixel>* second) const {
+        for (unsigned int x = 0; x < dimensions.width; ++x) {
+            if (first[x] != second[x]) { return false; }
+        }
+        return true;
     }
 
+    void Terminal::scroll_moved_rows() const {
+        const int height = static_cast<int>(dimensions.height);
 
-    // Private:
-    void Terminal::draw_pixel(const std::optional<Pixel> pixel) const {
+        // only new frame is hashed (buffer hashes are kept up to date as buffer changes), on large frames in bands too
+        const auto hash_rows = [this](FrameWriter&, const unsigned int begin, const unsigned int end) {
+            for (unsigned int y = begin; y < end; ++y) { pixel_row_hashes[y] = row_hash(pixels[y]); }
+        };
+        if (!run_in_bands(hash_rows)) { hash_rows(writer, 0, height); }
+        if (height < 3) { return; }
+
+        int first_changed = -1, last_changed = -1;
+        for (int y = 0; y < height; ++y) {
+            if (pixel_row_hashes[y] != buffer_row_hashes[y]) {
+                if (first_changed < 0) { first_changed = y; }
+                last_changed = y;
+            }
+        }
+        if (first_changed < 0) { return; }
+
+        /*
+         *  For every shift find the longest block of rows where new row is the old row 'shift' rows below (or above),
+         *  block is scored by how many changed rows it would fix (unchanged rows don't need to be drawn anyway).
+         */
+        struct Block { int score = 0, shift = 0, start = 0, end = 0; } best;
+        for (int shift = -max_scroll_shift; shift <= max_scroll_shift; ++shift) {
+            if (shift == 0) { continue; }
+            const int from = std::max(first_changed, -shift);
+            const int to = std::min(last_changed, height - 1 - shift);
+
+            int block_start = -1, block_score = 0;
+            for (int y = from; y <= to + 1; ++y) {
+                const bool moved = y <= to
+                    && pixel_row_hashes[y] == buffer_row_hashes[y + shift]
+                    && rows_equal(pixels[y], buffer[y + shift]);
+                if (moved) {
+                    if (block_start < 0) { block_start = y; block_score = 0; }
+                    if (pixel_row_hashes[y] != buffer_row_hashes[y]) { block_score++; }
+                    continue;
+                }
+                if (block_start >= 0 && block_score > best.score) { best = Block{block_score, shift, block_start, y}; }
+                block_start = -1;
+            }
+        }
+        // scroll sequence costs about as much as drawing short row, so it's used only when it saves more than uncovered rows cost
+        if (best.score < 2 || best.score <= std::abs(best.shift)) { return; }
+
+        // scroll region covers the block and rows uncovered by the shift (setting region moves cursor to left top corner)
+        const int distance = std::abs(best.shift);
+        const int top = best.shift > 0 ? best.start : best.start + best.shift;
+        const int bottom = best.shift > 0 ? best.end - 1 + best.shift : best.end - 1;
+        writer.output += "\033[" + std::to_string(top + 1) + ";" + std::to_string(bottom + 1) + "r";
+        append_sequence(writer.output, distance, best.shift > 0 ? 'S' : 'T');
+        writer.output += "\033[r";
+        writer.cursor = Position{0, 0};
+
+        // buffer now matches terminal: rows moved (their hashes with them), and uncovered rows are blank
+        const auto blank_row = [this](const int y) {
+            std::fill_n(buffer[y], dimensions.width, std::nullopt);
+            buffer_row_hashes[y] = row_hash(buffer[y]);
+        };
+        if (best.shift > 0) {
+            std::rotate(buffer + top, buffer + top + distance, buffer + bottom + 1);
+            std::rotate(buffer_row_hashes.begin() + top, buffer_row_hashes.begin() + top + distance, buffer_row_hashes.begin() + bottom + 1);
+            for (int y = bottom + 1 - distance; y <= bottom; ++y) { blank_row(y); }
+        }
+        else {
+            std::rotate(buffer + top, buffer + bottom + 1 - distance, buffer + bottom + 1);
+            std::rotate(buffer_row_hashes.begin() + top, buffer_row_hashes.begin() + bottom + 1 - distance, buffer_row_hashes.begin() + bottom + 1);
+            for (int y = top; y < top + distance; ++y) { blank_row(y); }
+        }
+    }
+
+    void Terminal::diff_rows(FrameWriter& band, const unsigned int begin, const unsigned int end) const {
+        for (unsigned int y = begin; y < end; ++y) {
+            for (unsigned int x = 0; x < dimensions.width; ++x) {
+                if (pixels[y][x] != buffer[y][x]) {
+                    // here we can just swap pixel for new one (and update buffer)
+                    buffer[y][x] = pixels[y][x];
+                    // right half of wide character is drawn together with its left half
+                    if (is_wide_continuation(pixels[y][x])) { continue; }
+
+                    // move cursor to changed pixel (cheapest way from where it is), and print pixel
+                    move_cursor(band, Position{y, x});
+                    advance_cursor(band, draw_pixel(band.output, pixels[y][x], x));
+                }
+            }
+            // row of buffer is now the same as row of frame
+            buffer_row_hashes[y] = pixel_row_hashes[y];
+        }
+    }
+    void Terminal::serialize_rows(FrameWriter& band, const unsigned int begin, const unsigned int end) const {
+        for (unsigned int y = begin; y < end; ++y) {
+            // when finish printing row (x-axis) go to next line (carriage return too, terminal doesn't have to translate newline),
+            // there is no newline after last row, so screen doesn't scroll
+            if (y > 0) { band.output += "\r\n"; }
+            for (unsigned int x = 0; x < dimensions.width; ++x) {
+                if (is_wide_continuation(pixels[y][x])) { continue; }
+                draw_pixel(band.output, pixels[y][x], x);
+            }
+        }
+    }
+
+    bool Terminal::run_in_bands(const std::function<void(FrameWriter&, unsigned int, unsigned int)>& rows) const {
+        // on small frames waking threads costs more than they save
+        if (workers == nullptr || dimensions.width * dimensions.height < min_parallel_cells) { return false; }
+
+        // more bands than threads, so band with many changes doesn't hold up the others
+        const unsigned int band_count = std::min(workers->size() * 2, std::max(dimensions.height / min_band_height, 1u));
+        if (band_count < 2) { return false; }
+        if (band_writers.size() < band_count) { band_writers.resize(band_count); }
+
+        const unsigned int band_height = (dimensions.height + band_count - 1) / band_count;
+        workers->run(band_count, [&](const std::size_t band) {
+            FrameWriter& band_writer = band_writers[band];
+            band_writer.output.clear();
+            band_writer.cursor_bytes_saved = 0;
+            // band doesn't know where previous band left the cursor, so its first move is absolute
+            band_writer.cursor.reset();
+            const unsigned int begin = std::min<unsigned int>(band * band_height, dimensions.height);
+            rows(band_writer, begin, std::min(begin + band_height, dimensions.height));
+        });
+
+        // bands are joined in order, cursor is where the last band that moved it left it
+        for (unsigned int band = 0; band < band_count; ++band) {
+            const FrameWriter& band_writer = band_writers[band];
+            if (band_writer.output.empty()) { continue; }
+            writer.output += band_writer.output;
+            writer.cursor = band_writer.cursor;
+            writer.cursor_bytes_saved += band_writer.cursor_bytes_saved;
+        }
+        return true;
+    }
+    void Terminal::setDiffThreads(unsigned int threads) {
+        if (threads == 0) { threads = std::max(std::thread::hardware_concurrency(), 1u); }
+        // calling thread works too
+        workers = threads > 1 ? std::make_unique<WorkerPool>(threads - 1) : nullptr;
+    }
+
+    void Terminal::move_cursor(FrameWriter& band, const Position target) const {
+        // before planner, every changed cell cost save cursor, absolute move and restore cursor
+        band.motion.clear();
+        append_cursor_position(band.motion, target);
+        const std::size_t absolute_cost = band.motion.size() + 6;
+        bool overwrite_gap = false;
+
+        if (band.cursor.has_value() && band.cursor->y == target.y && band.cursor->x == target.x) { band.motion.clear(); }
+        else if (band.cursor.has_value()) {
+            const Position from = band.cursor.value();
+            const auto best_cost = [&] { return band.motion.size() + (overwrite_gap ? band.overwritten_gap.size() : 0); };
+            const auto consider = [&](const std::string& candidate) {
+                if (candidate.size() < best_cost()) {
+                    band.motion = candidate;
+                    overwrite_gap = false;
+                }
+            };
+            // cells before target are already up to date, so drawing them again just moves cursor
+            const auto consider_gap = [&](const std::string& prefix, const unsigned int column) {
+                if (target.x - column > max_overwritten_gap || !render_gap(band, target.y, column, target.x)) { return; }
+                if (prefix.size() + band.gap.size() < best_cost()) {
+                    band.motion = prefix;
+                    std::swap(band.gap, band.overwritten_gap);
+                    overwrite_gap = true;
+                }
+            };
+            // horizontal moves from 'column', after vertical part of move
+            const auto consider_row = [&](const std::string& vertical, const unsigned int column) {
+                std::string candidate = vertical;
+                if (column == target.x) { consider(candidate); return; }
+
+                if (target.x > column) {
+                    append_sequence(candidate, target.x - column, 'C');
+                    consider(candidate);
+                    consider_gap(vertical, column);
+                }
+                else {
+                    if (column - target.x == 1) { candidate += '\b'; }
+                    else { append_sequence(candidate, column - target.x, 'D'); }
+                    consider(candidate);
+
+                    // carriage return, then forward
+                    candidate = vertical + '\r';
+                    if (target.x > 0) { append_sequence(candidate, target.x, 'C'); }
+                    consider(candidate);
+                    if (target.x > 0) { consider_gap(vertical + '\r', 0); }
+                }
+                // absolute column
+                candidate = vertical;
+                append_sequence(candidate, target.x + 1, 'G');
+                consider(candidate);
+            };
+
+            std::string vertical;
+            if (target.y > from.y) { append_sequence(vertical, target.y - from.y, 'B'); }
+            else if (target.y < from.y) { append_sequence(vertical, from.y - target.y, 'A'); }
+            consider_row(vertical, from.x);
+
+            // CR LF moves down and to the first column at once
+            if (target.y > from.y && target.y - from.y <= max_newline_moves) {
+                vertical.clear();
+                for (unsigned int i = from.y; i < target.y; ++i) { vertical += "\r\n"; }
+                consider_row(vertical, 0);
+            }
+        }
+
+        band.output += band.motion;
+        if (overwrite_gap) { band.output += band.overwritten_gap; }
+        band.cursor_bytes_saved += absolute_cost - band.motion.size() - (overwrite_gap ? band.overwritten_gap.size() : 0);
+        band.cursor = target;
+    }
+    void Terminal::synchronize_frame(const std::size_t frame_start) const {
+        // empty frame doesn't need an update at all
+        if (!capabilities.synchronized_output || writer.output.size() == frame_start) { return; }
+        writer.output.insert(frame_start, "\033[?2026h");
+        writer.output += "\033[?2026l";
+    }
+    bool Terminal::render_gap(FrameWriter& band, const unsigned int y, const unsigned int from, const unsigned int to) const {
+        band.gap.clear();
+        for (unsigned int x = from; x < to; ++x) {
+            // only cells that take exactly one column (so cursor lands exactly on target)
+            const std::optional<Pixel>& pixel = pixels[y][x];
+            if (pixel.has_value() && !pixel.value().character.is_ascii()) { return false; }
+            draw_pixel(band.gap, pixel, x);
+        }
+        return true;
+    }
+    void Terminal::advance_cursor(FrameWriter& band, const unsigned int width) const {
+        if (!band.cursor.has_value()) { return; }
+        // after writing into last column terminal waits with wrapping, so position isn't reliable
+        if (band.cursor->x + width >= dimensions.width) { band.cursor.reset(); return; }
+        band.cursor->x += width;
+    }
+
+    bool Terminal::is_wide_continuation(const std::optional<Pixel> &pixel) {
+        return pixel.has_value() && pixel.value().character.is_wide_continuation();
+    }
+    unsigned int Terminal::draw_pixel(std::string& out, const std::optional<Pixel> pixel, const unsigned int x) const {
         // if pixel is empty option, just output spacer
-        if (pixel == std::nullopt) { std::cout << " " << reset; }
+        if (pixel == std::nullopt) { out += ' '; out += reset; }
         else {
             // check if pixel has character to print
-            if (pixel.value().character != std::nullopt) {
+            if (pixel.value().character.has_value()) {
+                const Glyph character = pixel.value().character;
+                // wide character doesn't fit in last column (it would wrap to next line), so spacer is drawn instead
+                const bool fits = character.is_ascii() || x + glyphs.width(character) <= dimensions.width;
                 // if true print character with background and foreground (character) color
-                std::cout
-                    << get_background_escape_code(pixel.value().background_color)
-                    << get_foreground_escape_code(pixel.value().foreground_color)
-                    << pixel.value().character.value()
-                    << reset;
+                out += get_background_escape_code(pixel.value().background_color);
+                out += get_foreground_escape_code(pixel.value().foreground_color);
+                out += fits ? glyphs.bytes(character) : " ";
+                out += reset;
+                return fits ? glyphs.width(character) : 1;
             }
             else {
                 // if not, just print spacer with specified background color
-                std::cout
-                    << get_background_escape_code(pixel.value().background_color)
-                    << " "
-                    << reset;
+                out += get_background_escape_code(pixel.value().background_color);
+                out += ' ';
+                out += reset;
             }
         }
+        // everything else takes one column
+        return 1;
     }
 
     Dimension Terminal::get_terminal_dimensions() {
@@ -138,14 +479,14 @@ namespace TerminalUI {
 
     #ifdef _WIN32
     #include <windows.h>
-        void Terminal::hideCursor() {
+        void Terminal::hideCursor() const {
             HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
             CONSOLE_CURSOR_INFO cursorInfo;
             GetConsoleCursorInfo(consoleHandle, &cursorInfo);
             cursorInfo.bVisible = false;
             SetConsoleCursorInfo(consoleHandle, &cursorInfo);
         }
-        void Terminal::showCursor() {
+        void Terminal::showCursor() const {
             HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
             CONSOLE_CURSOR_INFO cursorInfo;
             GetConsoleCursorInfo(consoleHandle, &cursorInfo);
@@ -153,13 +494,13 @@ namespace TerminalUI {
             SetConsoleCursorInfo(consoleHandle, &cursorInfo);
         }
     #else
-        void Terminal::hideCursor() {
-            std::cout << "\033[?25l";
-            std::cout.flush();
+        void Terminal::hideCursor() const {
+            writer.output += "\033[?25l";
+            flush();
         }
-        void Terminal::showCursor() {
-            std::cout << "\033[?25h";
-            std::cout.flush();
+        void Terminal::showCursor() const {
+            writer.output += "\033[?25h";
+            flush();
         }
     #endif
 }
\ No newline at end of file
@@ -1,63 +1,36 @@
 #ifndef TERMINAL_H
 #define TERMINAL_H
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
-namespace TerminalUI {
-
-    enum class Color {
-        NONE,
-        WHITE,
-        BLACK,
-        RED,
-        GREEN,
-        BLUE,
-        YELLOW
-    };
-
-    // ANSI escape codes for ForegroundColors
-    constexpr const char* ForegroundColorCodes[] = {
-        "", // None (Default color)
-        "\033[37m", // WHITE
-        "\033[30m", // BLACK
-        "\033[31m", // RED
-        "\033[32m", // GREEN
-        "\033[34m", // BLUE
-        "\033[33m"  // YELLOW
-    };
-
-    // ANSI escape codes for BackgroundColors
-    constexpr const char* BackgroundColorCodes[] = {
-        "", // None (Default color)
-        "\033[47m", // WHITE
-        "\033[40m", // BLACK
-        "\033[41m", // RED
-        "\033[42m", // GREEN
-        "\033[44m", // BLUE
-        "\033[43m"  // YELLOW
-    };
+#include "capabilities.h"
+#include "glyph.h"
+#include "output_sink.h"
+#include "palette.h"
+#include "worker_pool.h"
 
-    // Helper function to retrieve the corresponding escape code for the colors
-    constexpr const char* get_foreground_escape_code(Color color) {
-        return ForegroundColorCodes[static_cast<int>(color)];
-    }
-    constexpr const char* get_background_escape_code(Color color) {
-        return BackgroundColorCodes[static_cast<int>(color)];
-    }
+namespace TerminalUI {
 
     struct Pixel {
         // change of foreground color will only appear when rendering character, ('character' field needs to be set)
         Color foreground_color = Color::WHITE;
         Color background_color = Color::BLACK;
         // This option will render character instead of full pixel, character color will be set to foreground_color
-        std::optional<char> character;
+        Glyph character;
 
-        // implementation to compare two Pixel struct (mainly for buffer purpose)
+        // implementation to compare two Pixel struct (mainly for buffer purpose), whole cell is compared as one word
         bool operator!=(const Pixel& other) const {
-            return foreground_color != other.foreground_color ||
-                   background_color != other.background_color ||
-                   character != other.character;
+            return std::bit_cast<std::uint32_t>(*this) != std::bit_cast<std::uint32_t>(other);
         }
     };
+    // colors and characters are table indices, so cell stays small no matter how many colors (or which characters) are used
+    static_assert(sizeof(Pixel) == 4, "Pixel should stay compact, it's stored twice for every terminal cell");
 
     struct Dimension {
         unsigned int height = 0;
@@ -69,30 +42,140 @@ namespace TerminalUI {
         unsigned int x = 0;
     };
 
+    // what the last drawn frame cost on the output
+    struct FrameOutput {
+        std::size_t bytes_written = 0;
+        // bytes saved by cursor planner, compared to save cursor, absolute move and restore cursor for every changed cell
+        std::size_t cursor_bytes_saved = 0;
+    };
+
+    struct SpriteView;
+    class AsciicastRecorder;
+
     class Terminal {
         mutable std::optional<Pixel>** buffer;
         mutable bool first_frame_drawn = false;
 
-        const char* reset = "\033[0m";
-        void draw_pixel(std::optional<Pixel> pixel) const;
+        /*
+         *  Bytes of frame and state of writing them (real cursor position, and scratch strings for planning cursor moves).
+         *  Main writer holds whole frame, when frame is diffed in parallel every band of rows has its own writer.
+         */
+        struct FrameWriter {
+            // written to sink at once (keeps capacity between frames)
+            std::string output;
+            // real cursor position on terminal (unknown after writing into last column, terminals wait there with wrapping)
+            std::optional<Position> cursor;
+            std::size_t cursor_bytes_saved = 0;
+            // scratch strings for planning cursor moves
+            std::string motion;
+            std::string gap;
+            std::string overwritten_gap;
+        };
+        mutable FrameWriter writer;
+        OutputSink* sink;
+        // bytes given to sink so far (the delivered ones are these without sink's pending bytes)
+        mutable std::size_t bytes_sent = 0;
+        // gets copy of everything given to sink (nothing if output isn't recorded)
+        AsciicastRecorder* recorder = nullptr;
+
+        // threads for diffing large frames (nothing if it's done on one thread)
+        std::unique_ptr<WorkerPool> workers;
+        mutable std::vector<FrameWriter> band_writers;
+        /*
+         *  Splits rows into bands, runs 'rows' for every band on worker threads (each band writes into its own writer),
+         *  and joins band outputs in order into main writer. Returns false (without doing anything) if frame is too small for that.
+         */
+        bool run_in_bands(const std::function<void(FrameWriter&, unsigned int, unsigned int)>& rows) const;
+        // diffs rows [begin, end) against buffer, and writes changed cells (pixel row hashes have to be up to date)
+        void diff_rows(FrameWriter& band, unsigned int begin, unsigned int end) const;
+        // writes rows [begin, end) whole (rows are separated with CR LF)
+        void serialize_rows(FrameWriter& band, unsigned int begin, unsigned int end) const;
 
-        static void hideCursor();
-        static void showCursor();
+        const char* reset = "\033[0m";
+        // appends pixel to 'out', returns how many columns it took
+        unsigned int draw_pixel(std::string& out, std::optional<Pixel> pixel, unsigned int x) const;
+        static bool is_wide_continuation(const std::optional<Pixel> &pixel);
+        void flush() const;
+
+        mutable FrameOutput last_frame_output;
+
+        Capabilities capabilities{};
+        // wraps frame (already in output) between begin and end of synchronized update, if terminal supports it
+        void synchronize_frame(std::size_t frame_start) const;
+        /*
+         *  Moves cursor to target the cheapest way from where it is (like curses' mvcur): staying put for contiguous runs,
+         *  CR / CR LF, relative moves, absolute column or row, or drawing short gap of unchanged cells again.
+         */
+        void move_cursor(FrameWriter& band, Position target) const;
+        // renders unchanged cells [from, to) of row into band's 'gap', false if some of them isn't single column
+        bool render_gap(FrameWriter& band, unsigned int y, unsigned int from, unsigned int to) const;
+        void advance_cursor(FrameWriter& band, unsigned int width) const;
+
+        /*
+         *  Hashes of rows (of pixels and buffer), used for finding rows that moved up or down between frames.
+         *  Pixel rows are hashed every frame, buffer hashes are updated wherever buffer rows are written, moved or cleared.
+         */
+        mutable std::vector<std::uint64_t> pixel_row_hashes;
+        mutable std::vector<std::uint64_t> buffer_row_hashes;
+        [[nodiscard]] std::uint64_t row_hash(const std::optional<Pixel>* row) const;
+        [[nodiscard]] bool rows_equal(const std::optional<Pixel>* first, const std::optional<Pixel>* second) const;
+        /*
+         *  When block of rows moved vertically (for example scrolled list), it's moved on terminal with scroll region
+         *  (DECSTBM and SU/SD), instead of drawing every cell again. Buffer is shifted the same way, so diff has to draw only uncovered rows.
+         */
+        void scroll_moved_rows() const;
+
+        void allocate();
+        void deallocate();
+
+        void hideCursor() const;
+        void showCursor() const;
 
         protected:
             static Dimension get_terminal_dimensions();
             std::optional<Pixel>** pixels;
+            // non-ASCII characters used by this terminal
+            GlyphTable glyphs;
 
         public:
             // better to use this helper struct, because calling sizeof on array of pixels is inefficient (and it's really a pointer, so there are other issue)
             Dimension dimensions;
 
-            explicit Terminal(Dimension dimensions = get_terminal_dimensions());
+            // without sink terminal writes to stdout
+            explicit Terminal(Dimension dimensions = get_terminal_dimensions(), OutputSink* sink = nullptr);
+
+            GlyphTable& glyphTable() { return glyphs; }
+            [[nodiscard]] FrameOutput lastFrameOutput() const { return last_frame_output; }
+            /*
+             *  Output the sink didn't deliver yet (slow link). Buffer is what the terminal shows once it's delivered,
+             *  so frame drawn after pending output is gone is diffed against what the terminal really has.
+             */
+            [[nodiscard]] std::size_t pendingOutput() const { return sink->pendingBytes(); }
+            [[nodiscard]] std::size_t deliveredOutput() const { return bytes_sent - std::min(sink->pendingBytes(), bytes_sent); }
+            void flushPendingOutput() const { sink->flushPending(); }
+            /*
+             *  Output from now on is copied into recording (recorder has to outlive terminal, or be unset before it's destroyed).
+             *  Recording starts with modes terminal has set, so it replays the same.
+             */
+            void setRecorder(AsciicastRecorder* output_recorder);
+
+            // what terminal supports (nothing by default), enables bracketed paste if it's supported
+            void setCapabilities(Capabilities detected);
+            [[nodiscard]] Capabilities terminalCapabilities() const { return capabilities; }
+            /*
+             *  Large frames (from about 250x160 cells) are diffed and written in bands of rows on this many threads,
+             *  1 turns it off (default), 0 uses all cores.
+             */
+            void setDiffThreads(unsigned int threads);
 
         virtual void setPixel(Pixel pixel, Position position) const;
+            // copies sprite rows onto the screen (clipped to it), empty cells are copied too (they clear what was there)
+            void blit(const SpriteView& sprite, Position position) const;
             void draw() const;
             void fresh_draw() const;
             void clear() const;
+            // changes size of the screen, pixels are cleared and next frame is drawn from scratch
+            virtual void resize(Dimension new_dimensions);
             // only for deallocating memory
             virtual ~Terminal();
     };
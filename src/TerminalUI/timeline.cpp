@@ -0,0 +1,79 @@
+#include "timeline.h"
+
+#include <algorithm>
+
+namespace TerminalUI {
+    namespace {
+        double ease(const Easing easing, const double t) {
+            switch (easing) {
+                case Easing::LINEAR: return t;
+                case Easing::EASE_IN: return t * t;
+                case Easing::EASE_OUT: return t * (2 - t);
+                case Easing::EASE_IN_OUT: return t < 0.5 ? 2 * t * t : -1 + (4 - 2 * t) * t;
+            }
+            return t;
+        }
+    }
+
+    Timeline::AnimationId Timeline::start(const Clock::duration duration, const Clock::duration delay, const Easing easing, std::function<void()> on_finish) {
+        const AnimationId id = next_id++;
+        // animations started during frame start at the time of that frame, so all of them stay in sync
+        animations.push_back(Animation{id, current_time + delay, duration, easing, std::move(on_finish)});
+        return id;
+    }
+
+    void Timeline::cancel(const AnimationId id) {
+        std::erase_if(animations, [id](const Animation& animation) { return animation.id == id; });
+    }
+
+    double Timeline::progress(const AnimationId id) const {
+        const Animation* animation = find(id);
+        if (animation == nullptr) { return 1.0; }
+        if (current_time <= animation->start) { return 0.0; }
+        if (animation->duration <= Clock::duration::zero()) { return 1.0; }
+
+        const double elapsed = std::chrono::duration<double>(current_time - animation->start).count();
+        const double total = std::chrono::duration<double>(animation->duration).count();
+        return ease(animation->easing, std::min(elapsed / total, 1.0));
+    }
+
+    bool Timeline::advance(const Clock::time_point now) {
+        current_time = now;
+
+        // callbacks are called after removing animations, so they can safely start new ones
+        std::vector<std::function<void()>> finished_callbacks;
+        bool any_finished = false;
+        std::erase_if(animations, [&](Animation& animation) {
+            if (now < animation.start + animation.duration) { return false; }
+            if (animation.on_finish) { finished_callbacks.push_back(std::move(animation.on_finish)); }
+            any_finished = true;
+            return true;
+        });
+
+        for (const auto& callback : finished_callbacks) { callback(); }
+        return any_finished;
+    }
+
+    bool Timeline::isAnimating() const {
+        return std::ranges::any_of(animations, [this](const Animation& animation) { return animation.start <= current_time; });
+    }
+
+    std::optional<Clock::time_point> Timeline::nextDeadline(const Clock::time_point last_frame) const {
+        std::optional<Clock::time_point> deadline;
+        for (const Animation& animation : animations) {
+            const Clock::time_point needed = animation.start <= current_time
+                // running animation: next frame after one frame interval (but not later than its end, so last frame is exact)
+                ? std::min(last_frame + frame_interval, animation.start + animation.duration)
+                // delayed animation: first frame when it starts
+                : animation.start;
+            if (!deadline.has_value() || needed < deadline.value()) { deadline = needed; }
+        }
+        return deadline;
+    }
+
+    // Private:
+    const Timeline::Animation* Timeline::find(const AnimationId id) const {
+        const auto animation = std::ranges::find(animations, id, &Animation::id);
+        return animation == animations.end() ? nullptr : &*animation;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace TerminalUI {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Easing {
+        LINEAR,
+        EASE_IN,
+        EASE_OUT,
+        EASE_IN_OUT
+    };
+
+    /*
+     *  Time based animations, progress depends only on time (not on number of rendered frames).
+     *  Renderer advances timeline once per loop iteration, and asks it when next frame is needed,
+     *  so when nothing is animated renderer can just wait for input instead of rendering frames nobody needs.
+     *  Animation can start with delay (so it's also a timer), and it can call back when it's finished.
+     */
+    class Timeline {
+        public:
+            using AnimationId = std::uint32_t;
+
+        private:
+            struct Animation {
+                AnimationId id;
+                Clock::time_point start;
+                Clock::duration duration;
+                Easing easing;
+                std::function<void()> on_finish;
+            };
+            std::vector<Animation> animations{};
+            AnimationId next_id = 1;
+            // time of current frame, every read during one frame sees the same time
+            Clock::time_point current_time = Clock::now();
+            Clock::duration frame_interval = std::chrono::microseconds(1000000 / 60);
+
+            [[nodiscard]] const Animation* find(AnimationId id) const;
+
+        public:
+            AnimationId start(Clock::duration duration, Clock::duration delay = Clock::duration::zero(), Easing easing = Easing::LINEAR, std::function<void()> on_finish = {});
+            // removes animation without calling its callback
+            void cancel(AnimationId id);
+
+            // eased progress from 0 to 1 (finished, cancelled or unknown animations are at 1)
+            [[nodiscard]] double progress(AnimationId id) const;
+            [[nodiscard]] bool isRunning(AnimationId id) const { return find(id) != nullptr; }
+            template <typename V>
+            [[nodiscard]] V interpolate(AnimationId id, V from, V to) const {
+                return static_cast<V>(from + (to - from) * progress(id));
+            }
+
+            /*
+             *  Moves timeline to 'now', finished animations are removed and their callbacks are called.
+             *  Returns true if any animation finished (so state could have changed, and frame should be rendered).
+             */
+            bool advance(Clock::time_point now);
+            // true if some animation is in progress at current time (it needs new frame every frame interval)
+            [[nodiscard]] bool isAnimating() const;
+            /*
+             *  Time when next frame is needed, counting from last rendered frame:
+             *  last_frame + frame interval if something is animating, start of the next delayed animation if not,
+             *  or nothing if there are no animations at all.
+             */
+            [[nodiscard]] std::optional<Clock::time_point> nextDeadline(Clock::time_point last_frame) const;
+
+            void setFrameInterval(const Clock::duration interval) { frame_interval = interval; }
+            [[nodiscard]] Clock::duration frameInterval() const { return frame_interval; }
+            [[nodiscard]] Clock::time_point now() const { return current_time; }
+    };
+}
+
+#endif //TIMELINE_H
@@ -0,0 +1,65 @@
+#include "worker_pool.h"
+
+namespace TerminalUI {
+    WorkerPool::WorkerPool(const unsigned int thread_count) {
+        threads.reserve(thread_count);
+        for (unsigned int i = 0; i < thread_count; ++i) {
+            threads.emplace_back(&WorkerPool::work, this);
+        }
+    }
+
+    void WorkerPool::run(const std::size_t count, const std::function<void(std::size_t)>& job) {
+        {
+            std::lock_guard lock(mutex);
+            task = &job;
+            task_count = count;
+            task_subsystem = Diagnostics::currentSubsystem();
+            next_task = 0;
+            busy = threads.size();
+            ++generation;
+        }
+        work_available.notify_all();
+
+        runTasks();
+
+        std::unique_lock lock(mutex);
+        work_done.wait(lock, [this] { return busy == 0; });
+        task = nullptr;
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        work_available.notify_all();
+        for (std::thread& thread : threads) { thread.join(); }
+    }
+
+    // Private:
+    void WorkerPool::work() {
+        std::uint64_t finished_generation = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                work_available.wait(lock, [&] { return stopping || generation != finished_generation; });
+                if (stopping) { return; }
+                finished_generation = generation;
+            }
+
+            {
+                const Diagnostics::MemoryScope memory_scope(task_subsystem);
+                runTasks();
+            }
+
+            std::lock_guard lock(mutex);
+            if (--busy == 0) { work_done.notify_one(); }
+        }
+    }
+
+    void WorkerPool::runTasks() {
+        for (std::size_t index = next_task.fetch_add(1); index < task_count; index = next_task.fetch_add(1)) {
+            (*task)(index);
+        }
+    }
+}
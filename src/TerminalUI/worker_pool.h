@@ -0,0 +1,55 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Diagnostics/memory_accounting.h"
+
+namespace TerminalUI {
+    /*
+     *  Small persistent pool of threads for splitting one job into tasks (for example bands of rows of a frame).
+     *  Threads are started once and sleep between jobs, calling thread takes tasks too,
+     *  so one job costs just waking threads up (not creating them).
+     */
+    class WorkerPool {
+        std::vector<std::thread> threads{};
+        std::mutex mutex{};
+        std::condition_variable work_available{};
+        std::condition_variable work_done{};
+
+        // current job, tasks are taken by whichever thread is free
+        const std::function<void(std::size_t)>* task = nullptr;
+        std::size_t task_count = 0;
+        // allocations of tasks are charged to subsystem of thread that started the job
+        Diagnostics::Subsystem task_subsystem = Diagnostics::Subsystem::OTHER;
+        std::atomic<std::size_t> next_task{0};
+        // threads that haven't finished current job yet
+        std::size_t busy = 0;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+
+        void work();
+        void runTasks();
+
+        public:
+            // threads in addition to calling thread
+            explicit WorkerPool(unsigned int thread_count);
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            // how many threads work on a job (calling thread included)
+            [[nodiscard]] unsigned int size() const { return threads.size() + 1; }
+            // runs task for every index from 0 to count - 1, returns when all of them are finished
+            void run(std::size_t count, const std::function<void(std::size_t)>& job);
+
+            ~WorkerPool();
+    };
+}
+
+#endif //WORKER_POOL_H
@@ -1,13 +1,28 @@
 #include <algorithm>
+#include <charconv>
+#include <cstdlib>
 #include <deque>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <unordered_map>
 
 #include "TerminalUI/renderer.h"
 #include "TerminalUI/renderers/rowRenderer/row_renderer.hpp"
+#include "TerminalUI/renderers/rowRenderer/components/keyboard_component.hpp"
 #include "TerminalUI/renderers/rowRenderer/components/list_component.hpp"
+#include "Diagnostics/memory_accounting.h"
+#include "Dictionary/dawg.h"
+#include "Dictionary/word_list.hpp"
+#include "Scoreboard/writer.h"
+#include "Solver/adversary.h"
+#include "Solver/feedback.hpp"
+#include "Solver/hint_worker.h"
+#include "Solver/opening_book.h"
+#include "Solver/partition.hpp"
 
 enum class AppState {
     Loading,
@@ -18,7 +33,8 @@ enum class AppState {
     Scoreboard
 };
 
-static const std::string WordlyLogoASCII[] = {
+// logo is rasterized at compile time, drawing it is just copying its rows
+static constexpr char WordlyLogoArt[][57] = {
     R"(  __      __                   __   ___                 )",
     R"( /\ \  __/\ \                 /\ \ /\_ \                )",
     R"( \ \ \/\ \ \ \    ___   _ __  \_\ \\//\ \    __  __     )",
@@ -29,32 +45,339 @@ static const std::string WordlyLogoASCII[] = {
     R"(                                                 /\___/ )",
     R"(                                                 \/__/  )"
 };
+static constexpr auto WordlyLogo = TerminalUI::makeSprite(WordlyLogoArt);
+
+// tile colors (standard Wordle palette by default, on terminals without 24-bit colors nearest 256-color is used)
+struct Theme {
+    TerminalUI::Color correct = TerminalUI::Palette::rgb(0x53, 0x8d, 0x4e);
+    TerminalUI::Color present = TerminalUI::Palette::rgb(0xb5, 0x9f, 0x3b);
+    TerminalUI::Color absent = TerminalUI::Palette::rgb(0x3a, 0x3a, 0x3c);
+    TerminalUI::Color tile_text = TerminalUI::Palette::rgb(0xff, 0xff, 0xff);
+    // keys that no word continues typed letters with
+    TerminalUI::Color unavailable_key = TerminalUI::Palette::rgb(0x5a, 0x5a, 0x5c);
+};
+
+/*
+ *  Boards of multi-board mode (Quordle-style): every guess is played on all boards that aren't solved yet.
+ *  Feedback of a guess for all those boards is scored in one batch, and every board keeps its tiles rasterized in its own block,
+ *  which is rebuilt only when the board changes (guess played on it, or new layout), frames just copy its rows.
+ */
+class MultiBoard {
+    public:
+        // grid of boards that fits the screen (compact tiles are one cell wide, without spacing between letters)
+        struct Layout {
+            unsigned int columns = 1;
+            unsigned int rows = 1;
+            unsigned int tile_width = 2;
+            unsigned int spacing = 3;
+            unsigned int board_width = 0;
+            unsigned int board_height = 0;  // guess rows visible on every board (latest guesses are shown when not all fit)
+
+            [[nodiscard]] unsigned int width() const { return columns * board_width + (columns - 1) * spacing; }
+            [[nodiscard]] unsigned int height() const { return rows * board_height + (rows - 1); }
+        };
+
+        /*
+         *  Layout that shows the most guess rows of every board (up to all of them), wide tiles are preferred when both fit,
+         *  then grid closest to the shape of the area (cells are about twice as high as wide). Nothing if boards don't fit at all.
+         */
+        static std::optional<Layout> layoutFor(const TerminalUI::Dimension area, const unsigned int board_count, const unsigned int word_length, const unsigned int max_guesses) {
+            std::optional<Layout> best;
+            long best_shape = 0;
+            for (const unsigned int tile_width : {2u, 1u}) {
+                for (unsigned int columns = 1; columns <= board_count; ++columns) {
+                    Layout layout{columns, (board_count + columns - 1) / columns, tile_width, tile_width == 2 ? 3u : 1u};
+                    layout.board_width = word_length * tile_width - (tile_width - 1);
+                    if (layout.width() > area.width || layout.rows - 1 >= area.height) { continue; }
+                    layout.board_height = std::min((area.height - (layout.rows - 1)) / layout.rows, max_guesses);
+                    if (layout.board_height == 0) { continue; }
+
+                    const long shape = std::labs(static_cast<long>(layout.width()) - 2 * static_cast<long>(layout.height()));
+                    if (!best.has_value() || layout.board_height > best->board_height
+                        || (layout.board_height == best->board_height && layout.tile_width == best->tile_width && shape < best_shape)) {
+                        best = layout;
+                        best_shape = shape;
+                    }
+                }
+            }
+            return best;
+        }
+
+    private:
+        struct Board {
+            std::uint32_t answer = 0;  // index into answers
+            std::vector<Solver::Pattern> feedback{};
+            bool solved = false;
+            // rasterized tiles (layout.board_height rows of layout.board_width cells)
+            std::vector<TerminalUI::Pixel> block{};
+            bool dirty = true;
+        };
+
+        Dictionary::WordList answers;
+        unsigned int word_length;
+        unsigned int max_guesses;
+        Theme theme;
+        std::vector<Board> boards;
+        std::vector<std::string> guesses{};
+        // scratch of batched scoring (boards still in play, their answers and feedback)
+        std::vector<std::size_t> batch_boards{};
+        std::vector<std::uint32_t> batch_answers{};
+        std::vector<Solver::Pattern> batch_feedback{};
+
+        std::optional<Layout> layout;
+        TerminalUI::Dimension layout_area{};
+
+        void rasterize(Board& board) const {
+            board.block.assign(static_cast<std::size_t>(layout->board_width) * layout->board_height, TerminalUI::Pixel{TerminalUI::Color::NONE, TerminalUI::Color::NONE, std::nullopt});
+            // latest guesses are visible when they don't all fit
+            const std::size_t played = board.feedback.size();
+            const std::size_t first = played > layout->board_height ? played - layout->board_height : 0;
+            for (unsigned int row = 0; row < layout->board_height; ++row) {
+                const std::size_t guess = first + row;
+                // solved board has nothing below its last guess
+                if (guess >= max_guesses || (board.solved && guess >= played)) { break; }
+                for (unsigned int c = 0; c < word_length; ++c) {
+                    auto& cell = board.block[row * layout->board_width + c * layout->tile_width];
+                    if (guess >= played) {
+                        cell = TerminalUI::Pixel{TerminalUI::Color::WHITE, TerminalUI::Color::NONE, '_'};
+                        continue;
+                    }
+                    TerminalUI::Color tile_color = theme.absent;
+                    switch (Solver::letter_state(board.feedback[guess], c)) {
+                        case Solver::LetterState::CORRECT: tile_color = theme.correct; break;
+                        case Solver::LetterState::PRESENT: tile_color = theme.present; break;
+                        case Solver::LetterState::ABSENT: break;
+                    }
+                    cell = TerminalUI::Pixel{theme.tile_text, tile_color, guesses[guess][c]};
+                }
+            }
+            board.dirty = false;
+        }
+
+    public:
+        MultiBoard(const Dictionary::WordList answers, const unsigned int board_count, const unsigned int max_guesses, const Theme theme) :
+            answers(answers), word_length(answers.word_length()), max_guesses(max_guesses), theme(theme), boards(board_count) {}
+
+        // new game with different answer on every board (if there are enough answers)
+        void reset(std::mt19937& engine) {
+            // partial shuffle (picks are distinct, in random order), answers repeat only when there are fewer of them than boards
+            std::vector<std::uint32_t> picked(answers.size());
+            std::iota(picked.begin(), picked.end(), 0);
+            for (std::size_t i = 0; i < boards.size(); ++i) {
+                const std::size_t rest = i % picked.size();
+                std::uniform_int_distribution<std::size_t> dist(rest, picked.size() - 1);
+                std::swap(picked[rest], picked[dist(engine)]);
+                boards[i].answer = picked[rest];
+                boards[i].feedback.clear();
+                boards[i].feedback.reserve(max_guesses);
+                boards[i].solved = false;
+                boards[i].dirty = true;
+            }
+            guesses.clear();
+        }
+
+        // plays guess on all unsolved boards (scored in one batch), only those boards are rasterized again
+        void play(const std::string_view guess) {
+            batch_boards.clear();
+            batch_answers.clear();
+            for (std::size_t i = 0; i < boards.size(); ++i) {
+                if (boards[i].solved) { continue; }
+                batch_boards.push_back(i);
+                batch_answers.push_back(boards[i].answer);
+            }
+            batch_feedback.resize(batch_answers.size());
+            Solver::score_guess_batch(guess, answers, batch_answers, batch_feedback);
+
+            guesses.emplace_back(guess);
+            const Solver::Pattern solved_pattern = Solver::solved_pattern(word_length);
+            for (std::size_t i = 0; i < batch_boards.size(); ++i) {
+                Board& board = boards[batch_boards[i]];
+                board.feedback.push_back(batch_feedback[i]);
+                board.solved = batch_feedback[i] == solved_pattern;
+                board.dirty = true;
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const { return boards.size(); }
+        [[nodiscard]] std::size_t guessCount() const { return guesses.size(); }
+        [[nodiscard]] std::size_t solvedCount() const { return std::ranges::count_if(boards, &Board::solved); }
+        // answers of all boards (in board order), separated with ','
+        [[nodiscard]] std::string answerList() const {
+            std::string list;
+            for (const Board& board : boards) {
+                if (!list.empty()) { list += ','; }
+                list += answers[board.answer];
+            }
+            return list;
+        }
+
+        /*
+         *  Places boards into selected layer of row renderer, centered in area (that starts at 'origin'),
+         *  returns false if they don't fit in it. Blocks change in place, so they are added as rows (layer sees changed cells).
+         */
+        template <typename App>
+        bool draw(TerminalUI::RowRenderer<App>* row_renderer, const TerminalUI::Position origin, const TerminalUI::Dimension area) {
+            if (!layout.has_value() || area.height != layout_area.height || area.width != layout_area.width) {
+                layout = layoutFor(area, boards.size(), word_length, max_guesses);
+                layout_area = area;
+                for (Board& board : boards) { board.dirty = true; }
+            }
+            if (!layout.has_value()) { return false; }
+
+            const unsigned int left = origin.x + (area.width - layout->width()) / 2;
+            const unsigned int top = origin.y + (area.height - layout->height()) / 2;
+            for (std::size_t i = 0; i < boards.size(); ++i) {
+                if (boards[i].dirty) { rasterize(boards[i]); }
+                const unsigned int column = i % layout->columns, row = i / layout->columns;
+                const std::span<const TerminalUI::Pixel> block = boards[i].block;
+                for (unsigned int line = 0; line < layout->board_height; ++line) {
+                    row_renderer->addRow(block.subspan(line * layout->board_width, layout->board_width), TerminalUI::Position{
+                        top + row * (layout->board_height + 1) + line,
+                        left + column * (layout->board_width + layout->spacing)
+                    });
+                }
+            }
+            return true;
+        }
+};
+
+struct GameOptions {
+    // max number of guesses before game is lost (word length comes from dictionary)
+    unsigned int max_guesses = 6;
+    // boards played at once (more than one is multi-board mode, every guess is played on all of them)
+    unsigned int board_count = 1;
+    // no word is chosen, every guess gets feedback that keeps the most words possible (single board only)
+    bool adversarial = false;
+    // threads (calling one included) adversary uses to compare equally bad feedback two guesses ahead
+    unsigned int solver_threads = 1;
+    Theme theme{};
+    // word graph of dictionary (built once and shared by games), if it's not set every game builds its own
+    std::shared_ptr<const Dictionary::Dawg> dictionary_graph{};
+    // precomputed hints (it has to be made for the same word lists), without it hints are computed when asked for
+    std::shared_ptr<const Solver::OpeningBook> opening_book{};
+    // hint for the first guess (out of the book) is the same in every game, the first game that computes it shares it with the others
+    std::shared_ptr<std::optional<std::size_t>> first_hint{};
+    // hints out of the book are computed by this worker (shared by games, so sessions don't start threads), without it game has its own
+    std::shared_ptr<Solver::HintWorker> hint_worker{};
+    // results are appended by this writer (shared by games, so one thread writes them), without it game has its own for "scoreboard.db"
+    std::shared_ptr<Scoreboard::Writer> scoreboard{};
+};
 
 class WordlyTUI {
     AppState game_state = AppState::Loading;
-    unsigned int loading_bar_progress = 0;
+    // renderer is stopped with next frame (so app can end without killing whole process, for example in server session)
+    bool quit_requested = false;
+    // state for which static rows were drawn into background layer
+    std::optional<AppState> background_state;
+    std::optional<TerminalUI::Timeline::AnimationId> loading_animation;
 
     std::optional<ListComponent<WordlyTUI>> menu_list;
+    std::optional<KeyboardComponent<WordlyTUI>> keyboard;
 
     std::vector<char> word_input{};
+    // multi-board mode (nothing in classic game with one board)
+    std::optional<MultiBoard> boards;
+    // adversarial mode, word_to_guess is set only when game ends (to one of words still possible)
+    std::unique_ptr<TerminalUI::WorkerPool> solver_workers;
+    std::optional<Solver::Adversary> adversary;
     std::string word_to_guess{};
-    std::vector<std::string> words_to_guess{};
+    Dictionary::WordList words_to_guess{};
     std::vector<std::string> guessed_words{};
-
-    std::vector<std::string> english_5_word_dictionary{};
+    // feedback is scored once, when guess is accepted (renderer just reads it)
+    std::vector<Solver::Pattern> guessed_feedback{};
+    // state of letters for on-screen keyboard (updated when guess is accepted, keyboard shows it after tiles are revealed)
+    Solver::LetterMasks letter_masks{};
+    // last guess tiles are flipped one by one, game waits with result (and input) until they are all revealed
+    bool reveal_pending = false;
+    bool revealing = false;
+    std::optional<TerminalUI::Timeline::AnimationId> reveal_animation;
+    std::optional<AppState> state_after_reveal;
+    // texts that don't change between frames are formatted once, when state changes
+    std::string result_message{};
+    // hint shown until next guess, book is followed as long as player guesses what it suggests
+    std::shared_ptr<const Solver::OpeningBook> opening_book{};
+    std::optional<Solver::OpeningBook::NodeIndex> book_node;
+    // answers (indices into words_to_guess) that still fit feedback of all guesses
+    std::vector<std::uint32_t> hint_candidates{};
+    std::string hint_message{};
+    // without book first hint is the slowest one (all answers are candidates), it's the same in every game, so it's computed once
+    std::shared_ptr<std::optional<std::size_t>> first_hint{};
+    /*
+     *  Hint out of the book takes tens of milliseconds, so it's computed by hint worker and shown when it's ready
+     *  (animated "computing" message keeps frames coming meanwhile). Hint asked before the last guess is cancelled.
+     */
+    std::shared_ptr<Solver::HintWorker> hint_worker{};
+    std::shared_ptr<Solver::PendingHint> pending_hint{};
+    std::uint64_t hint_generation = 0;
+    std::uint64_t pending_hint_generation = 0;
+    std::optional<TerminalUI::Timeline::AnimationId> hint_animation;
+    // all records (newest first), padded to the same width so scrolled rows stay in place
+    std::vector<std::string> scoreboard_records{};
+    bool scoreboard_available = false;
+    std::shared_ptr<Scoreboard::Writer> scoreboard_writer{};
+    // shown on scoreboard when results can't be saved (writer keeps retrying)
+    std::string scoreboard_error{};
+    // first visible record, and how many records fit on the screen (known after first frame of scoreboard)
+    std::size_t scoreboard_offset = 0;
+    std::size_t scoreboard_visible_records = 1;
+
+    Dictionary::WordList dictionary{};
+    // answers prefix queries while typing, and checks guesses
+    std::shared_ptr<const Dictionary::Dawg> dictionary_graph{};
+    unsigned int word_length;
+    unsigned int max_guesses;
+    Theme theme;
     public:
-        WordlyTUI(const std::vector<std::string> &english_5_word_dictionary, const std::vector<std::string> words_to_guess) {
-            this->english_5_word_dictionary = english_5_word_dictionary;
+        // word lists are just views, storage has to outlive the game (both lists need to have the same word length)
+        WordlyTUI(const Dictionary::WordList dictionary, const Dictionary::WordList words_to_guess, const GameOptions options = {}) {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::GAME);
+            this->dictionary = dictionary;
             this->words_to_guess = words_to_guess;
+            this->word_length = dictionary.word_length();
+            this->max_guesses = options.max_guesses;
+            this->theme = options.theme;
+            this->dictionary_graph = options.dictionary_graph != nullptr ? options.dictionary_graph : std::make_shared<const Dictionary::Dawg>(dictionary);
+            this->scoreboard_writer = options.scoreboard != nullptr ? options.scoreboard : std::make_shared<Scoreboard::Writer>("scoreboard.db");
+            if (options.opening_book != nullptr && options.opening_book->matches(dictionary, words_to_guess)) { this->opening_book = options.opening_book; }
+            this->first_hint = options.first_hint != nullptr ? options.first_hint : std::make_shared<std::optional<std::size_t>>();
+            this->hint_worker = options.hint_worker != nullptr ? options.hint_worker : std::make_shared<Solver::HintWorker>(options.solver_threads);
+            reset_hints();
 
             // chose random word to guess
             std::random_device random_device;
             std::mt19937 engine{random_device()};
             std::uniform_int_distribution<int> dist(0, this->words_to_guess.size() - 1);
-            this->word_to_guess = words_to_guess[dist(engine)];
+            this->word_to_guess = this->words_to_guess[dist(engine)];
+            if (options.board_count > 1) {
+                boards.emplace(words_to_guess, options.board_count, max_guesses, theme);
+                boards->reset(engine);
+            } else if (options.adversarial) {
+                if (options.solver_threads > 1) { solver_workers = std::make_unique<TerminalUI::WorkerPool>(options.solver_threads - 1); }
+                adversary.emplace(dictionary, words_to_guess, solver_workers.get());
+            }
+        }
+
+        // hint still being computed isn't waited for, worker just drops it
+        ~WordlyTUI() {
+            if (pending_hint != nullptr) { pending_hint->cancel(); }
         }
 
         void app_flow_control(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::GAME);
+            if (quit_requested) {
+                row_renderer->stop();
+                return;
+            }
+
+            // static parts of screens go to background layer once (when state changes), every frame only dynamic rows are added
+            if (background_state != game_state) {
+                row_renderer->clearScreen();
+                row_renderer->selectLayer(TerminalUI::Layer::BACKGROUND);
+                render_static_screen(row_renderer);
+                background_state = game_state;
+            }
+            row_renderer->clearRows();
+
             switch (game_state) {
                 case AppState::Loading:
                     render_loading_screen(row_renderer);
@@ -62,32 +385,19 @@ class WordlyTUI {
                 case AppState::InMenu:
                     render_in_menu_screen(row_renderer);
                     break;
-                case AppState::GameOver:
-                    row_renderer->clearScreen();
-                    row_renderer->addRow("GAME OVER!", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("You should have guess: " + word_to_guess, TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("try again later...", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    break;
-                case AppState::Congratulation:
-                    row_renderer->clearScreen();
-                    row_renderer->addRow("YOU WIN!", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("You were able to guess word in " + std::to_string(guessed_words.size()) + " tries.", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                    break;
                 case AppState::InGame:
                     render_in_game_screen(row_renderer);
                     break;
-                case AppState::Settings:
-                    render_settings_screen(row_renderer);
-                    break;
                 case AppState::Scoreboard:
                     render_scoreboard_screen(row_renderer);
                     break;
+                case AppState::GameOver: case AppState::Congratulation: case AppState::Settings:
+                    // nothing changes on those screens
+                    break;
             }
         }
         void handle_interrupts(int input) {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::GAME);
             switch (game_state) {
                 case AppState::Loading:
                     break;
@@ -98,54 +408,86 @@ class WordlyTUI {
                         std::string selected = menu_list.value().get_current_option();
                         if (selected == "Play") { game_state = AppState::InGame; }
                         else if (selected == "Settings") { game_state = AppState::Settings; }
-                        else if (selected == "Scoreboard") { game_state = AppState::Scoreboard; }
-                        else if (selected == "Quit") { std::exit(EXIT_SUCCESS); }
+                        else if (selected == "Scoreboard") { load_scoreboard(); game_state = AppState::Scoreboard; }
+                        else if (selected == "Quit") { quit_requested = true; }
                     }
                     break;
                 case AppState::InGame:
-                    /* letters a-z */ if (input >= 97 && input <= 122 && word_input.size() < 5) { word_input.emplace_back(input); }
+                    if (boards.has_value()) { handle_multi_board_input(input); break; }
+                    if (revealing) { break; }
+                    /* ? */ if (input == 63) { show_hint(); }
+                    /* letters a-z */ if (input >= 97 && input <= 122 && word_input.size() < word_length) { word_input.emplace_back(input); }
                     /* backspace */ if (input == 127 && word_input.size() > 0) { word_input.pop_back(); }
-                    /* enter */ if (input == 10 && word_input.size() == 5) {
+                    /* enter */ if (input == 10 && word_input.size() == word_length) {
                         const std::string current_word(word_input.begin(), word_input.end());
                         // check if word exists
-                        if (count(english_5_word_dictionary.begin(), english_5_word_dictionary.end(), current_word) ) {
+                        if (dictionary_graph->contains(current_word)) {
                             // add word as guess
                             guessed_words.emplace_back(current_word);
+                            guessed_feedback.emplace_back(adversary.has_value() ? respond_adversarially(current_word) : Solver::score_guess(current_word, word_to_guess));
                             word_input.clear();
+                            letter_masks.add(current_word, guessed_feedback.back());
+                            update_hints(current_word, guessed_feedback.back());
+                            // reveal animation is started with next frame (timeline belongs to renderer)
+                            reveal_pending = true;
+                            revealing = true;
 
                             // check if user guess correctly
-                            if (current_word == word_to_guess) { game_state = AppState::Congratulation; }
-
+                            if (guessed_feedback.back() == Solver::solved_pattern(word_length)) {
+                                result_message = "You were able to guess word in " + std::to_string(guessed_words.size()) + " tries.";
+                                state_after_reveal = AppState::Congratulation;
+                            }
                             // too much guesses you lose
-                            if (guessed_words.size() > 5) { game_state = AppState::GameOver; }
+                            else if (guessed_words.size() >= max_guesses) {
+                                if (adversary.has_value()) { word_to_guess = words_to_guess[adversary->candidates().front()]; }
+                                result_message = "You should have guess: " + word_to_guess;
+                                state_after_reveal = AppState::GameOver;
+                            }
                         }
                     }
                     break;
                 case AppState::Congratulation: case AppState::GameOver:
                     if (input == 113) {
-                        // save results to file
-                        std::ofstream scoreboard("scoreboard.db", std::ios::app);
-                        if (scoreboard) {
+                        // save results (record is only queued, writer thread appends it to file, so input isn't blocked by slow disk)
+                        {
+                            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SCOREBOARD);
                             const auto now = std::chrono::system_clock::now();
                             const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-                            const std::string line = std::to_string(timestamp) + ";" + word_to_guess + ";" + std::to_string(guessed_words.size()) + ";";
-                            scoreboard << line << std::endl;
-
-                            scoreboard.close();
+                            // multi-board game is recorded with answers of all boards (separated with ',') instead of word
+                            const std::string answer = boards.has_value() ? boards->answerList() : word_to_guess;
+                            const std::size_t guess_count = boards.has_value() ? boards->guessCount() : guessed_words.size();
+                            // result: 1 if word (or all boards) was guessed, 0 if not (older records don't have it)
+                            std::string record = std::to_string(timestamp) + ";" + answer + ";" + std::to_string(guess_count) + ";"
+                                + (game_state == AppState::Congratulation ? "1" : "0") + ";";
+                            // multi-board record ends with number of solved boards
+                            if (boards.has_value()) { record += std::to_string(boards->solvedCount()) + ";"; }
+                            scoreboard_writer->append(record);
                         }
                         // chose random word to guess
                         std::random_device random_device;
                         std::mt19937 engine{random_device()};
                         std::uniform_int_distribution<int> dist(0, this->words_to_guess.size() - 1);
                         this->word_to_guess = words_to_guess[dist(engine)];
+                        if (boards.has_value()) { boards->reset(engine); }
+                        if (adversary.has_value()) { adversary->reset(); }
                         // clear vars
                         word_input.clear();
                         guessed_words.clear();
+                        guessed_feedback.clear();
+                        letter_masks = {};
+                        reset_hints();
 
                         game_state = AppState::InMenu;
                     }
                     break;
-                case AppState::Settings: case AppState::Scoreboard:
+                case AppState::Scoreboard:
+                    /* arrow down */ if (input == 4348699 && scoreboard_offset + scoreboard_visible_records < scoreboard_records.size()) { scoreboard_offset++; }
+                    /* arrow up */ if (input == 4283163 && scoreboard_offset > 0) { scoreboard_offset--; }
+                    if (input == 113) {
+                        game_state = AppState::InMenu;
+                    }
+                    break;
+                case AppState::Settings:
                     if (input == 113) {
                         game_state = AppState::InMenu;
                     }
@@ -154,10 +496,44 @@ class WordlyTUI {
         }
 
     protected:
+        void render_static_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) const {
+            switch (game_state) {
+                case AppState::Loading:
+                    row_renderer->blit(WordlyLogo, TerminalUI::RowPosition {
+                        TerminalUI::VerticalPosition::MIDDLE,
+                        TerminalUI::HorizontalPosition::CENTER,
+                        TerminalUI::RowAlignment::CENTER
+                    });
+                    break;
+                case AppState::GameOver:
+                    row_renderer->addRow("GAME OVER!", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow(result_message, TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow("try again later...", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    break;
+                case AppState::Congratulation:
+                    row_renderer->addRow("YOU WIN!", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow(result_message, TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    break;
+                case AppState::Settings:
+                    render_settings_screen(row_renderer);
+                    break;
+                case AppState::InGame:
+                    row_renderer->addRow(boards.has_value() ? "every guess is played on all boards"
+                        : adversary.has_value() ? "no word is chosen yet, press '?' for a hint" : "press '?' for a hint",
+                        TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                    break;
+                case AppState::InMenu: case AppState::Scoreboard:
+                    break;
+            }
+        }
+
         void render_loading_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
-            row_renderer->clearRows();
-            for (const std::string row : WordlyLogoASCII) {
-                row_renderer->addRow(row, TerminalUI::RowPosition {
+            // logo is in background layer, empty rows keep space for it, so loading bar lands below logo
+            for (unsigned int i = 0; i < WordlyLogo.height; ++i) {
+                row_renderer->addRow("", TerminalUI::RowPosition {
                     TerminalUI::VerticalPosition::MIDDLE,
                     TerminalUI::HorizontalPosition::CENTER,
                     TerminalUI::RowAlignment::CENTER
@@ -172,31 +548,24 @@ class WordlyTUI {
                 });
             }
 
-            // Loading bar (yeah, its fake)
-            std::vector<TerminalUI::Pixel> loading_bar_pixels;
-            for (auto px = 0; px <= std::min(loading_bar_progress, static_cast<const unsigned int>(WordlyLogoASCII[0].length())); ++px) {
-                loading_bar_pixels.emplace_back(
-                    TerminalUI::Pixel {
-                    TerminalUI::Color::NONE,
-                    TerminalUI::Color::WHITE,
-                    std::nullopt
+            // Loading bar (yeah, its fake), it fills in constant time no matter how fast frames are rendered
+            if (!loading_animation.has_value()) {
+                loading_animation = row_renderer->timeline().start(std::chrono::milliseconds(600), TerminalUI::Clock::duration::zero(), TerminalUI::Easing::EASE_OUT, [this] {
+                    loading_animation.reset();
+                    game_state = AppState::InMenu;
                 });
             }
-
-            row_renderer->addRow(loading_bar_pixels, TerminalUI::RowPosition {
+            const auto loading_bar_progress = row_renderer->timeline().interpolate(loading_animation.value(), 0.0, static_cast<double>(WordlyLogo.width));
+            const auto loading_bar_pixels = row_renderer->emplaceRow(static_cast<unsigned int>(loading_bar_progress) + 1, TerminalUI::RowPosition {
                 TerminalUI::VerticalPosition::MIDDLE,
                 TerminalUI::HorizontalPosition::CENTER,
                 TerminalUI::RowAlignment::LEFT
             });
-
-            usleep(150);
-            loading_bar_progress++;
-
-            if (loading_bar_progress >= WordlyLogoASCII[0].length()) {
-                loading_bar_progress = 0;
-                game_state = AppState::InMenu;
-                row_renderer->clearScreen();
-            }
+            std::ranges::fill(loading_bar_pixels, TerminalUI::Pixel {
+                TerminalUI::Color::NONE,
+                TerminalUI::Color::WHITE,
+                std::nullopt
+            });
         }
 
         void render_in_menu_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) { // NOLINT(*-convert-member-functions-to-static)
@@ -215,151 +584,401 @@ class WordlyTUI {
                 });
             }
 
-            row_renderer->clearScreen();
-
             menu_list->drawComponent();
         }
 
-        void render_in_game_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) const { // NOLINT(*-convert-member-functions-to-static)
-            row_renderer->clearScreen();
-
-            // Loop over 6 rows (max number of rows)
-            for (int i = 0; i < 6; ++i) {
-                std::vector<TerminalUI::Pixel> letters;
-
-                if (i < guessed_words.size()) {
-                    // Render guessed words with colors
-                    for (int c = 0; c < 5; ++c) {
-                        TerminalUI::Color font_color = TerminalUI::Color::WHITE;
-                        char current_letter = guessed_words[i][c];
-
-                        // Determine color based on word_to_guess
-                        int letter_pos = word_to_guess.find(current_letter);
-                        if (letter_pos != std::string::npos) {
-                            font_color = (letter_pos == c) ? TerminalUI::Color::GREEN : TerminalUI::Color::YELLOW;
-                        }
+        void render_in_game_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) { // NOLINT(*-convert-member-functions-to-static)
+            if (boards.has_value()) {
+                render_multi_board_screen(row_renderer);
+                return;
+            }
+            // start flipping tiles of just accepted guess (result screen is shown after all tiles are revealed)
+            if (reveal_pending) {
+                reveal_pending = false;
+                reveal_animation = row_renderer->timeline().start(std::chrono::milliseconds(300) * word_length, TerminalUI::Clock::duration::zero(), TerminalUI::Easing::LINEAR, [this] {
+                    revealing = false;
+                    reveal_animation.reset();
+                    if (state_after_reveal.has_value()) {
+                        game_state = state_after_reveal.value();
+                        state_after_reveal.reset();
+                    }
+                });
+            }
+            // how many tiles of last guess are revealed (fractional part is flip of the next one)
+            const double revealed_tiles = revealing && reveal_animation.has_value()
+                ? row_renderer->timeline().progress(reveal_animation.value()) * word_length
+                : word_length;
+
+            // typed letters are highlighted as soon as no word starts with them
+            const bool valid_prefix = dictionary_graph->isPrefix(std::string_view(word_input.data(), word_input.size()));
+
+            // Loop over all rows (one for each possible guess)
+            for (unsigned int i = 0; i < max_guesses; ++i) {
+                // letters are separated by spacing cells, pixels are written straight into row storage
+                const auto letters = row_renderer->emplaceRow(word_length * 2 - 1, TerminalUI::RowPosition{
+                    TerminalUI::VerticalPosition::MIDDLE,
+                    TerminalUI::HorizontalPosition::CENTER,
+                    TerminalUI::RowAlignment::CENTER
+                });
+                std::ranges::fill(letters, TerminalUI::Pixel{
+                    TerminalUI::Color::NONE,
+                    TerminalUI::Color::NONE,
+                    std::nullopt
+                });
 
-                        letters.emplace_back(TerminalUI::Pixel{
-                            font_color,
+                for (unsigned int c = 0; c < word_length; ++c) {
+                    const bool last_guess = i + 1 == guessed_words.size();
+                    if (last_guess && revealed_tiles < c + 0.5) {
+                        // tile not revealed yet shows letter as typed, during first half of its flip it is edge-on (then it shows its color)
+                        const bool flipping = revealed_tiles >= c;
+                        letters[c * 2] = TerminalUI::Pixel{
+                            TerminalUI::Color::WHITE,
                             TerminalUI::Color::NONE,
-                            current_letter
-                        });
-
-                        // Add spacing between letters
-                        if (c < 4) {
-                            letters.emplace_back(TerminalUI::Pixel{
-                                TerminalUI::Color::NONE,
-                                TerminalUI::Color::NONE,
-                                std::nullopt
-                            });
+                            flipping ? '-' : guessed_words[i][c]
+                        };
+                    } else if (i < guessed_words.size()) {
+                        // Render guessed words with colors
+                        TerminalUI::Color tile_color = theme.absent;
+
+                        // Determine tile color based on feedback scored for this guess
+                        switch (Solver::letter_state(guessed_feedback[i], c)) {
+                            case Solver::LetterState::CORRECT: tile_color = theme.correct; break;
+                            case Solver::LetterState::PRESENT: tile_color = theme.present; break;
+                            case Solver::LetterState::ABSENT: break;
                         }
-                    }
-                } else if (i == guessed_words.size()) {
-                    // Display current input row
-                    for (int c = 0; c < 5; ++c) {
-                        letters.emplace_back(TerminalUI::Pixel{
-                            TerminalUI::Color::WHITE,
+
+                        letters[c * 2] = TerminalUI::Pixel{
+                            theme.tile_text,
+                            tile_color,
+                            guessed_words[i][c]
+                        };
+                    } else if (i == guessed_words.size()) {
+                        // Display current input row
+                        letters[c * 2] = TerminalUI::Pixel{
+                            valid_prefix || c >= word_input.size() ? TerminalUI::Color::WHITE : TerminalUI::Color::RED,
                             TerminalUI::Color::NONE,
                             (c < word_input.size()) ? word_input[c] : '_'
-                        });
-
-                        // Add spacing between letters
-                        if (c < 4) {
-                            letters.emplace_back(TerminalUI::Pixel{
-                                TerminalUI::Color::NONE,
-                                TerminalUI::Color::NONE,
-                                std::nullopt
-                            });
-                        }
-                    }
-                } else {
-                    // Display empty row as placeholders
-                    for (int c = 0; c < 5; ++c) {
-                        letters.emplace_back(TerminalUI::Pixel{
+                        };
+                    } else {
+                        // Display empty row as placeholders
+                        letters[c * 2] = TerminalUI::Pixel{
                             TerminalUI::Color::WHITE,
                             TerminalUI::Color::NONE,
                             '_'
-                        });
-
-                        // Add spacing between letters
-                        if (c < 4) {
-                            letters.emplace_back(TerminalUI::Pixel{
-                                TerminalUI::Color::NONE,
-                                TerminalUI::Color::NONE,
-                                std::nullopt
-                            });
-                        }
+                        };
                     }
                 }
+            }
+
+            // keyboard goes below guesses when there's room for it (rows of fps, hint with its spacing, and footer stay free)
+            if (row_renderer->screenSize().height >= max_guesses + KeyboardComponent<WordlyTUI>::height() + 5) {
+                if (!keyboard.has_value()) {
+                    keyboard.emplace(row_renderer, TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER},
+                        KeyboardComponent<WordlyTUI>::Colors{theme.tile_text, theme.absent, theme.present, theme.correct, theme.unavailable_key});
+                }
+                // letters of the last guess are colored after its tiles flip
+                if (!revealing) { keyboard->set_letters(letter_masks.absent, letter_masks.present, letter_masks.correct); }
+                // only letters some dictionary word continues typed ones with stay lit (none once whole word is typed)
+                keyboard->set_available(dictionary_graph->nextLetters(std::string_view(word_input.data(), word_input.size())));
+                row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                keyboard->drawComponent();
+            }
 
-                row_renderer->addRow(letters, TerminalUI::RowPosition{
-                    TerminalUI::VerticalPosition::MIDDLE,
-                    TerminalUI::HorizontalPosition::CENTER,
-                    TerminalUI::RowAlignment::CENTER
-                });
+            // hint floats above footer (empty row below it keeps footer visible)
+            poll_hint(row_renderer);
+            if (!hint_message.empty()) {
+                row_renderer->selectLayer(TerminalUI::Layer::OVERLAY);
+                row_renderer->addRow(hint_message, TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER}, TerminalUI::Color::BLACK, TerminalUI::Color::WHITE);
+                row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                row_renderer->selectLayer(TerminalUI::Layer::CONTENT);
+            }
+        }
+
+        void handle_multi_board_input(const int input) {
+            /* letters a-z */ if (input >= 97 && input <= 122 && word_input.size() < word_length) { word_input.emplace_back(input); }
+            /* backspace */ if (input == 127 && word_input.size() > 0) { word_input.pop_back(); }
+            /* enter */ if (input == 10 && word_input.size() == word_length) {
+                const std::string current_word(word_input.begin(), word_input.end());
+                if (!dictionary_graph->contains(current_word)) { return; }
+                boards->play(current_word);
+                word_input.clear();
+
+                const std::size_t solved = boards->solvedCount();
+                if (solved == boards->size()) {
+                    result_message = "You solved all " + std::to_string(boards->size()) + " boards in " + std::to_string(boards->guessCount()) + " tries.";
+                    game_state = AppState::Congratulation;
+                } else if (boards->guessCount() >= max_guesses) {
+                    result_message = "You solved " + std::to_string(solved) + " of " + std::to_string(boards->size()) + " boards.";
+                    game_state = AppState::GameOver;
+                }
             }
         }
 
-        static void render_settings_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
-            row_renderer->clearScreen();
-            row_renderer->addRow("Nothing Yet..", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+        void render_multi_board_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
+            // boards take the screen between top row (frame rate) and status, input and footer rows at the bottom
+            const TerminalUI::Dimension screen = row_renderer->screenSize();
+            const TerminalUI::Dimension area{screen.height > 5 ? screen.height - 5 : 0, screen.width};
+            if (!boards->draw(row_renderer, TerminalUI::Position{1, 0}, area)) {
+                row_renderer->addRow("Terminal is too small for all boards", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+            }
+
+            char status[64];
+            const int length = std::snprintf(status, sizeof(status), "solved %zu/%zu | guess %zu/%u", boards->solvedCount(), boards->size(), boards->guessCount() + 1, max_guesses);
+            row_renderer->addRow(std::string_view(status, std::max(length, 0)), TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+
+            // typed word (shared by all boards), red as soon as no word starts with it
+            const bool valid_prefix = dictionary_graph->isPrefix(std::string_view(word_input.data(), word_input.size()));
+            const auto letters = row_renderer->emplaceRow(word_length * 2 - 1, TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+            std::ranges::fill(letters, TerminalUI::Pixel{TerminalUI::Color::NONE, TerminalUI::Color::NONE, std::nullopt});
+            for (unsigned int c = 0; c < word_length; ++c) {
+                letters[c * 2] = TerminalUI::Pixel{
+                    valid_prefix || c >= word_input.size() ? TerminalUI::Color::WHITE : TerminalUI::Color::RED,
+                    TerminalUI::Color::NONE,
+                    c < word_input.size() ? word_input[c] : '_'
+                };
+            }
+            // keeps footer (background layer) visible
+            row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+        }
+
+        // feedback that keeps the most words possible, guessed word becomes the answer when it's the last one
+        Solver::Pattern respond_adversarially(const std::string_view guess) {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SOLVER);
+            const Solver::Pattern feedback = adversary->respond(guess);
+            if (feedback == Solver::solved_pattern(word_length)) { word_to_guess = guess; }
+            return feedback;
+        }
+
+        // every game starts at root of the book, with all answers possible
+        void reset_hints() {
+            book_node = opening_book != nullptr ? std::optional(opening_book->root()) : std::nullopt;
+            hint_candidates.resize(words_to_guess.size());
+            for (std::uint32_t i = 0; i < hint_candidates.size(); ++i) { hint_candidates[i] = i; }
+            hint_message.clear();
+            hint_generation++;
+        }
+
+        void update_hints(const std::string_view guess, const Solver::Pattern feedback) {
+            Solver::filter_candidates(guess, feedback, words_to_guess, hint_candidates);
+            // any other guess than the one from book leaves the book
+            if (book_node.has_value()) {
+                book_node = opening_book->guess(book_node.value()) == guess ? opening_book->next(book_node.value(), feedback) : std::nullopt;
+            }
+            hint_message.clear();
+            hint_generation++;
+        }
+
+        void show_hint() {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SOLVER);
+            if (book_node.has_value()) {
+                hint_message = "Hint: " + std::string(opening_book->guess(book_node.value())) + " (opening book, "
+                    + std::to_string(hint_candidates.size()) + " words left)";
+                return;
+            }
+            if (guessed_words.empty() && first_hint->has_value()) {
+                hint_message = "Hint: " + std::string(dictionary[first_hint->value()]) + " (computed once, "
+                    + std::to_string(hint_candidates.size()) + " words left)";
+                return;
+            }
+            // one hint is computed at a time, hint for earlier guesses isn't needed anymore
+            if (pending_hint != nullptr && pending_hint_generation == hint_generation) { return; }
+            if (pending_hint != nullptr) { pending_hint->cancel(); }
+
+            // out of the book guess is picked the same way as book generator does it (that's the slow part, book makes it instant)
+            pending_hint = hint_worker->submit(dictionary, words_to_guess, hint_candidates);
+            pending_hint_generation = hint_generation;
+            hint_message = "Hint: computing";
+        }
+
+        // takes hint once it's computed, until then "computing" message is animated (so renderer keeps making frames)
+        void poll_hint(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
+            if (pending_hint == nullptr) { return; }
+            const bool outdated = pending_hint_generation != hint_generation;
+            if (!outdated && !pending_hint->isReady()) {
+                if (hint_animation.has_value() && row_renderer->timeline().isRunning(hint_animation.value())) {
+                    hint_message = "Hint: computing" + std::string(row_renderer->timeline().interpolate(hint_animation.value(), 0, 4), '.');
+                    return;
+                }
+                hint_animation = row_renderer->timeline().start(std::chrono::milliseconds(400));
+                return;
+            }
+
+            if (hint_animation.has_value()) {
+                row_renderer->timeline().cancel(hint_animation.value());
+                hint_animation.reset();
+            }
+            const std::shared_ptr<Solver::PendingHint> hint = std::move(pending_hint);
+            if (outdated) {
+                hint->cancel();
+                return;
+            }
+            if (guessed_words.empty()) { *first_hint = hint->guess(); }
+            hint_message = "Hint: " + std::string(dictionary[hint->guess()]) + " (computed in " + std::to_string(hint->computeMilliseconds()) + " ms, "
+                + std::to_string(hint_candidates.size()) + " words left)";
+        }
+
+        void render_settings_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) const {
+            // memory of dictionary as flat list of words, and as word graph
+            char line[128];
+            int length = std::snprintf(line, sizeof(line), "Dictionary: %zu words, %u letters each", dictionary.size(), word_length);
+            row_renderer->addRow(std::string_view(line, std::max(length, 0)), TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+            length = std::snprintf(line, sizeof(line), "flat list: %.1f KiB, word graph: %.1f KiB (%zu nodes)",
+                dictionary.data().size() / 1024.0, dictionary_graph->memoryBytes() / 1024.0, dictionary_graph->nodeCount());
+            row_renderer->addRow(std::string_view(line, std::max(length, 0)), TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
             row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
             row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
         }
 
-        static void render_scoreboard_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
-            row_renderer->clearScreen();
-            std::ifstream scoreboard("scoreboard.db");
-            if (scoreboard) {
-                std::deque<std::string> lastLines;
-                std::string line;
-
-                // Read the file line by line
+        // reads all records from scoreboard file, and records still waiting for writer (once, when scoreboard is opened)
+        void load_scoreboard() {
+            const Diagnostics::MemoryScope memory_scope(Diagnostics::Subsystem::SCOREBOARD);
+            scoreboard_records.clear();
+            scoreboard_offset = 0;
+            scoreboard_error = scoreboard_writer->lastError().value_or("");
+
+            std::deque<std::string> lastLines;
+            std::string line;
+            {
+                /*
+                 *  Unwritten records are taken before file is read: record that isn't among them anymore is in the file already.
+                 *  Batch can be written while file is read, so unwritten records found in the file are dropped (file isn't locked,
+                 *  opening scoreboard never waits for writer's write or sync).
+                 */
+                const std::vector<std::string> unwritten = scoreboard_writer->unwritten();
+                std::unordered_map<std::string_view, std::size_t> unwritten_in_file;
+                for (const std::string& record : unwritten) { unwritten_in_file.try_emplace(record, 0); }
+                std::ifstream scoreboard(scoreboard_writer->filePath());
+
+                /*
+                 *  Read the file line by line. Every record ends with ';', line without it was torn by crash.
+                 *  Records without result field are older than result field, so after the first record with it
+                 *  a line without it is torn too (it's the beginning of a record cut after guess count).
+                 *  Multi-board records have one more field (solved boards), they are told apart by their answers field
+                 *  (list of answers, separated with ','), so multi-board record cut after result isn't read as single-board one.
+                 */
+                bool results_recorded = false;
                 while (std::getline(scoreboard, line)) {
+                    if (line.empty() || line.back() != ';') { continue; }
+                    const auto fields = std::ranges::count(line, ';');
+                    const std::size_t answers_begin = line.find(';') + 1;
+                    const bool multi_board = line.find(',', answers_begin) < line.find(';', answers_begin);
+                    if (multi_board ? fields != 5 : fields != 3 && fields != 4) { continue; }
+                    if (fields > 3) { results_recorded = true; }
+                    else if (results_recorded) { continue; }
+                    if (const auto found = unwritten_in_file.find(line); found != unwritten_in_file.end()) { found->second++; }
                     lastLines.push_back(line);
-                    // Keep only the last 10 lines
-                    if (lastLines.size() > 10) {
-                        lastLines.pop_front();
-                    }
                 }
+                for (const std::string& record : unwritten) {
+                    if (std::size_t& in_file = unwritten_in_file.at(record); in_file > 0) { in_file--; }
+                    else { lastLines.push_back(record); }
+                }
+                scoreboard_available = scoreboard.is_open() || !unwritten.empty();
+            }
+            if (!scoreboard_available) { return; }
+
+            // reverse lastLines, so the newest guesses are on top
+            std::ranges::reverse(lastLines);
+
+            for (const auto &line : lastLines) {
+                // Split the line
+                std::stringstream ss(line);
+                std::string timestampStr, word_to_guess, guessed_word_count, guessed, solved_boards;
+                std::getline(ss, timestampStr, ';');
+                std::getline(ss, word_to_guess, ';');
+                std::getline(ss, guessed_word_count, ';');
+                std::getline(ss, guessed, ';');
+                std::getline(ss, solved_boards, ';');
+
+                // otherwise broken line is skipped (result is "0" or "1", or missing in old records)
+                long long timestamp = 0;
+                unsigned int guess_count = 0;
+                if (std::from_chars(timestampStr.data(), timestampStr.data() + timestampStr.size(), timestamp).ec != std::errc{}
+                    || std::from_chars(guessed_word_count.data(), guessed_word_count.data() + guessed_word_count.size(), guess_count).ec != std::errc{}
+                    || word_to_guess.empty() || !(guessed.empty() || guessed == "0" || guessed == "1")) {
+                    continue;
+                }
+                // multi-board record has answers of all boards, and how many of them were solved
+                const std::size_t board_count = std::ranges::count(word_to_guess, ',') + 1;
+                std::size_t solved_count = 0;
+                if ((board_count > 1) != !solved_boards.empty()) { continue; }
+                if (!solved_boards.empty() && (std::from_chars(solved_boards.data(), solved_boards.data() + solved_boards.size(), solved_count).ec != std::errc{}
+                    || solved_count > board_count)) {
+                    continue;
+                }
+
+                // Convert timestamp to readable format
+                std::time_t time = static_cast<std::time_t>(timestamp);
+                char buffer[100];
+                std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+
+                // records without result field come from 6 guesses limit, where 6 tries meant not guessed
+                const bool was_guessed = guessed.empty() ? guess_count <= 5 : guessed == "1";
+                if (!solved_boards.empty()) {
+                    scoreboard_records.emplace_back(static_cast<std::string>(buffer) + ", Solved " + std::to_string(solved_count) + "/" + std::to_string(board_count)
+                        + " boards in " + guessed_word_count + " tries (" + board_answers(word_to_guess, board_count) + ")");
+                }
+                else if (!was_guessed) {
+                    scoreboard_records.emplace_back(static_cast<std::string>(buffer) + ", Not guessed '" + word_to_guess + "'");
+                }
+                else {
+                    scoreboard_records.emplace_back(static_cast<std::string>(buffer) + ", Guessed '" + word_to_guess + "' in " + guessed_word_count + " tries.");
+                }
+            }
+
+            // same width of all records keeps their column in place while scrolling (rows are centered)
+            std::size_t record_width = 0;
+            for (const auto &record : scoreboard_records) { record_width = std::max(record_width, record.size()); }
+            for (auto &record : scoreboard_records) { record.resize(record_width, ' '); }
+        }
 
-                // reverse lastLines, so the newest guesses are on top
-                std::ranges::reverse(lastLines);
+        // answers of multi-board record for scoreboard, long lists are cut (records would be wider than screen)
+        static std::string board_answers(const std::string_view list, const std::size_t board_count) {
+            constexpr std::size_t shown_answers = 4;
+            if (board_count <= shown_answers) {
+                std::string answers(list);
+                std::ranges::replace(answers, ',', ' ');
+                return answers;
+            }
+            std::size_t end = 0;
+            for (std::size_t i = 0; i < shown_answers; ++i) { end = list.find(',', end) + 1; }
+            std::string answers(list.substr(0, end - 1));
+            std::ranges::replace(answers, ',', ' ');
+            return answers + " +" + std::to_string(board_count - shown_answers);
+        }
 
-                row_renderer->addRow("Yours last 10 scores:", TerminalUI::RowPosition {TerminalUI::VerticalPosition::TOP, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+        void render_scoreboard_screen(TerminalUI::RowRenderer<WordlyTUI> *row_renderer) {
+            if (scoreboard_available && !scoreboard_records.empty()) {
+                // top padding, title and empty row, then position, save error and hint at the bottom (with empty row above them) take 6-7 rows
+                const unsigned int reserved_rows = scoreboard_error.empty() ? 6 : 7;
+                const unsigned int screen_height = row_renderer->screenSize().height;
+                scoreboard_visible_records = std::max(screen_height, reserved_rows + 1) - reserved_rows;
+                scoreboard_offset = std::min(scoreboard_offset, scoreboard_records.size() - std::min(scoreboard_visible_records, scoreboard_records.size()));
+
+                row_renderer->addRow("Your scores:", TerminalUI::RowPosition {TerminalUI::VerticalPosition::TOP, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
                 row_renderer->addRow("", TerminalUI::RowPosition {TerminalUI::VerticalPosition::TOP, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
-                for (const auto &line : lastLines) {
-                    // Split the line
-                    std::stringstream ss(line);
-                    std::string timestampStr, word_to_guess, guessed_word_count;
-                    std::getline(ss, timestampStr, ';');
-                    std::getline(ss, word_to_guess, ';');
-                    std::getline(ss, guessed_word_count, ';');
-
-                    // Convert timestamp to readable format
-                    long long timestamp = std::stoll(timestampStr);
-                    std::time_t time = static_cast<std::time_t>(timestamp);
-                    char buffer[100];
-                    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
-
-                    std::string record;
-                    if (std::stoi(guessed_word_count) > 5) {
-                        record = static_cast<std::string>(buffer) + ", Not guessed '" + word_to_guess + "'";
-                    }
-                    else {
-                        record = static_cast<std::string>(buffer) + ", Guessed '" + word_to_guess + "' in " + guessed_word_count + " tries.";
-                    }
-                    row_renderer->addRow(record, TerminalUI::RowPosition {
+                const std::size_t end = std::min(scoreboard_offset + scoreboard_visible_records, scoreboard_records.size());
+                for (std::size_t i = scoreboard_offset; i < end; ++i) {
+                    row_renderer->addRow(scoreboard_records[i], TerminalUI::RowPosition {
                         TerminalUI::VerticalPosition::TOP,
                         TerminalUI::HorizontalPosition::CENTER,
                         TerminalUI::RowAlignment::CENTER
                     });
                 }
 
-                scoreboard.close();
+                // position in history (only when it doesn't fit on the screen)
+                if (scoreboard_records.size() > scoreboard_visible_records) {
+                    char position[64];
+                    const int length = std::snprintf(position, sizeof(position), "%zu-%zu of %zu, arrows to scroll", scoreboard_offset + 1, end, scoreboard_records.size());
+                    row_renderer->addRow(std::string_view(position, std::max(length, 0)), TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
+                }
+            } else if (scoreboard_available) {
+                row_renderer->addRow("No scores yet.", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
             } else {
                 row_renderer->addRow("Can't open scoreboard file!", TerminalUI::RowPosition {TerminalUI::VerticalPosition::MIDDLE, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
             }
+            if (!scoreboard_error.empty()) {
+                row_renderer->addRow("Results aren't saved yet: " + scoreboard_error, TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER}, TerminalUI::Color::RED);
+            }
 
             row_renderer->addRow("press 'Q' to go back to menu", TerminalUI::RowPosition {TerminalUI::VerticalPosition::BOTTOM, TerminalUI::HorizontalPosition::CENTER, TerminalUI::RowAlignment::CENTER});
         }
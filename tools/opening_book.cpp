@@ -0,0 +1,201 @@
+/*
+ *  Generator of opening book for wordly_tui (decision tree of best guesses, see src/Solver/opening_book.h).
+ *  Every node gets the guess that splits its candidates into the smallest buckets (same scoring as hints in game),
+ *  then one child is made for every feedback pattern that leaves some candidates. Scoring guesses is split between cores.
+ *  Book is made for exact word lists, game ignores it when lists don't match.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/Dictionary/embedded_word_lists.hpp"
+#include "../src/Dictionary/external_word_list.h"
+#include "../src/Solver/opening_book.h"
+#include "../src/Solver/partition.hpp"
+#include "../src/TerminalUI/worker_pool.h"
+
+namespace {
+    // node of tree while it's built, edges are flattened when whole tree is done
+    struct BuildNode {
+        std::size_t guess = 0;
+        std::size_t candidate_count = 0;
+        std::vector<std::pair<Solver::Pattern, Solver::OpeningBook::NodeIndex>> children{};
+    };
+
+    class BookBuilder {
+        Dictionary::WordList guesses;
+        Dictionary::WordList answers;
+        unsigned int depth_limit;
+        TerminalUI::WorkerPool workers;
+        std::vector<BuildNode> nodes{};
+
+        // splitting small candidate sets between threads costs more than it saves
+        static constexpr std::size_t min_parallel_candidates = 16;
+
+        Solver::GuessChoice choose_guess(const std::vector<std::uint32_t>& candidates) {
+            // with one or two candidates guessing one of them is always best
+            if (candidates.size() <= 2) {
+                const std::string_view first = answers[candidates.front()];
+                std::size_t low = 0, high = guesses.size();
+                while (low < high) {
+                    const std::size_t middle = low + (high - low) / 2;
+                    if (guesses[middle] < first) { low = middle + 1; } else { high = middle; }
+                }
+                if (low < guesses.size() && guesses[low] == first) { return Solver::GuessChoice{low, 0, true}; }
+            }
+            if (candidates.size() < min_parallel_candidates || workers.size() == 1) {
+                return Solver::best_guess(guesses, answers, candidates, 0, guesses.size());
+            }
+
+            // every task scores its own range of guesses, results are combined in the same way no matter how work was split
+            const std::size_t task_count = workers.size() * 4;
+            std::vector<Solver::GuessChoice> results(task_count);
+            workers.run(task_count, [&](const std::size_t task) {
+                const std::size_t begin = guesses.size() * task / task_count, end = guesses.size() * (task + 1) / task_count;
+                results[task] = Solver::best_guess(guesses, answers, candidates, begin, end);
+            });
+            Solver::GuessChoice best;
+            for (const Solver::GuessChoice& result : results) {
+                if (result.better_than(best)) { best = result; }
+            }
+            return best;
+        }
+
+        Solver::OpeningBook::NodeIndex build(const std::vector<std::uint32_t>& candidates, const unsigned int depth) {
+            const Solver::OpeningBook::NodeIndex index = nodes.size();
+            const Solver::GuessChoice choice = choose_guess(candidates);
+            nodes.push_back(BuildNode{choice.guess, candidates.size()});
+            if (depth_limit != 0 && depth >= depth_limit) { return index; }
+
+            // candidates grouped by pattern (solved pattern needs no next guess)
+            const std::string_view guess = guesses[choice.guess];
+            const Solver::Pattern solved = Solver::solved_pattern(answers.word_length());
+            std::vector<std::vector<std::uint32_t>> buckets(Solver::pattern_count(answers.word_length()));
+            for (const std::uint32_t candidate : candidates) { buckets[Solver::score_guess(guess, answers[candidate])].push_back(candidate); }
+
+            for (Solver::Pattern pattern = 0; pattern < buckets.size(); ++pattern) {
+                // guess that doesn't split candidates at all (answers missing in guesses) would never end
+                if (pattern == solved || buckets[pattern].empty() || buckets[pattern].size() == candidates.size()) { continue; }
+                const Solver::OpeningBook::NodeIndex child = build(buckets[pattern], depth + 1);
+                nodes[index].children.emplace_back(pattern, child);
+            }
+            return index;
+        }
+
+        public:
+            BookBuilder(const Dictionary::WordList guesses, const Dictionary::WordList answers, const unsigned int depth_limit, const unsigned int threads) :
+                guesses(guesses), answers(answers), depth_limit(depth_limit), workers(threads - 1) {}
+
+            void build() {
+                std::vector<std::uint32_t> candidates(answers.size());
+                for (std::uint32_t i = 0; i < candidates.size(); ++i) { candidates[i] = i; }
+                nodes.clear();
+                build(candidates, 1);
+            }
+
+            [[nodiscard]] const std::vector<BuildNode>& tree() const { return nodes; }
+
+            // nodes and edges in book layout (edges of every node are contiguous and sorted by pattern)
+            void flatten(std::vector<Solver::OpeningBook::Node>& book_nodes, std::vector<Solver::OpeningBook::Edge>& book_edges) const {
+                book_nodes.clear();
+                book_edges.clear();
+                for (const BuildNode& node : nodes) {
+                    Solver::OpeningBook::Node book_node{};
+                    const std::string_view guess = guesses[node.guess];
+                    std::ranges::copy(guess, book_node.guess);
+                    book_node.first_edge = book_edges.size();
+                    book_node.edge_count = node.children.size();
+                    book_node.candidate_count = std::min<std::size_t>(node.candidate_count, 65535);
+                    book_nodes.push_back(book_node);
+                    for (const auto& [pattern, child] : node.children) { book_edges.push_back(Solver::OpeningBook::Edge{pattern, 0, child}); }
+                }
+            }
+    };
+
+    void print_usage(const char* program) {
+        std::cerr
+            << "Usage: " << program << " [options]\n"
+            << "  --dictionary <file>  word list of allowed guesses (default: embedded english list)\n"
+            << "  --answers <file>     word list of possible answers (default: embedded list, or --dictionary)\n"
+            << "  --length <4-8>       word length, requires --dictionary for other lengths than 5 (default: 5)\n"
+            << "  --depth <n>          guesses covered by the book, 0 for whole tree (default: 0)\n"
+            << "  --threads <n>        threads scoring guesses, 0 for all cores (default: 0)\n"
+            << "  --output <file>      where book is written (default: opening_book.db)\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::optional<std::string> dictionary_path, answers_path;
+    std::string output_path = "opening_book.db";
+    unsigned int word_length = Dictionary::Embedded::word_length;
+    unsigned int depth = 0, threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--dictionary") == 0 && has_value) { dictionary_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--answers") == 0 && has_value) { answers_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--length") == 0 && has_value) { word_length = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--depth") == 0 && has_value) { depth = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value) { threads = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--output") == 0 && has_value) { output_path = argv[++i]; }
+        else { print_usage(argv[0]); return EXIT_FAILURE; }
+    }
+    if (threads == 0) { threads = std::max(std::thread::hardware_concurrency(), 1u); }
+
+    // lists are loaded the same way as in game, so fingerprints match
+    Dictionary::WordList dictionary = Dictionary::Embedded::english_5_word_dictionary;
+    Dictionary::WordList answers = Dictionary::Embedded::wordle_answers_list;
+    std::unique_ptr<Dictionary::ExternalWordList> external_dictionary, external_answers;
+    try {
+        if (dictionary_path.has_value()) {
+            external_dictionary = std::make_unique<Dictionary::ExternalWordList>(dictionary_path.value(), word_length);
+            dictionary = external_dictionary->words();
+            if (!answers_path.has_value()) { answers = dictionary; }
+        }
+        if (answers_path.has_value()) {
+            external_answers = std::make_unique<Dictionary::ExternalWordList>(answers_path.value(), word_length);
+            answers = external_answers->words();
+        }
+    } catch (const std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (dictionary.word_length() != word_length || answers.word_length() != word_length || answers.empty() || dictionary.empty()) {
+        std::cerr << "There are no " << word_length << "-letter words in word lists" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    BookBuilder builder(dictionary, answers, depth, threads);
+    builder.build();
+
+    std::vector<Solver::OpeningBook::Node> nodes;
+    std::vector<Solver::OpeningBook::Edge> edges;
+    builder.flatten(nodes, edges);
+
+    Solver::OpeningBook::Header header{};
+    header.word_length = word_length;
+    header.depth = depth;
+    header.guesses_fingerprint = Solver::OpeningBook::fingerprint(dictionary);
+    header.answers_fingerprint = Solver::OpeningBook::fingerprint(answers);
+    try {
+        Solver::OpeningBook::write(output_path, header, nodes, edges);
+    } catch (const std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const std::size_t bytes = sizeof(header) + nodes.size() * sizeof(nodes[0]) + edges.size() * sizeof(edges[0]);
+    std::cout
+        << "opening: " << dictionary[builder.tree().front().guess] << "\n"
+        << "nodes: " << nodes.size() << ", edges: " << edges.size() << " (" << bytes / 1024.0 << " KiB)\n"
+        << "built in " << elapsed << " s on " << threads << " threads, written to " << output_path << "\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/*
+ *  Scripted client for wordly_tui server (--listen), for trying server with many sessions locally.
+ *  It opens sessions, reports window size like telnet client, and active sessions type keys from script (in loop).
+ *  At the end it prints how many sessions were served, and how much output they got.
+ *  Every active session has to reach result screen of a game at least once, otherwise script is broken and client fails.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+
+#include "../src/Server/socket.h"
+#include "../src/Server/telnet.h"
+
+namespace {
+    struct ClientSession {
+        int file_descriptor = -1;
+        bool active = false;
+        bool connected = false;
+        std::size_t next_key = 0;
+        std::size_t received_bytes = 0;
+        // result screens seen in output: printed characters are matched (without escape sequences and spaces, cursor moves can skip blank cells),
+        // end of printed text is kept, so text split between reads is found too
+        std::size_t results = 0;
+        std::string printed_tail{};
+        enum class Escape { NONE, STARTED, CSI } escape = Escape::NONE;
+    };
+
+    // texts of result screens (game won or lost), without spaces
+    constexpr std::string_view result_texts[] = {"YOUWIN!", "GAMEOVER!"};
+    constexpr std::size_t result_text_max = 9;
+
+    // counts result texts printed by session
+    void scan_output(ClientSession& session, const std::string_view output) {
+        std::string printed = session.printed_tail;
+        for (const char c : output) {
+            // two-byte escape sequence ends right after ESC, CSI sequence ends with its final byte
+            if (session.escape == ClientSession::Escape::STARTED) {
+                session.escape = c == '[' ? ClientSession::Escape::CSI : ClientSession::Escape::NONE;
+                continue;
+            }
+            if (session.escape == ClientSession::Escape::CSI) {
+                if (c >= '@' && c <= '~') { session.escape = ClientSession::Escape::NONE; }
+                continue;
+            }
+            if (c == '\033') { session.escape = ClientSession::Escape::STARTED; }
+            else if (c > ' ' && c < 127) { printed += c; }
+        }
+        for (const std::string_view result : result_texts) {
+            // matches that lie completely in kept tail were counted already
+            for (std::size_t at = printed.find(result); at != std::string::npos; at = printed.find(result, at + 1)) {
+                if (at + result.size() > session.printed_tail.size()) { session.results++; }
+            }
+        }
+        session.printed_tail = printed.substr(printed.size() - std::min(printed.size(), result_text_max - 1));
+    }
+
+    void print_usage(const char* program) {
+        std::cerr
+            << "Usage: " << program << " <address> [options]\n"
+            << "  --sessions <n>     number of sessions (default: 100)\n"
+            << "  --active <n>       how many of them type keys (default: 10)\n"
+            << "  --keys <script>    keys typed in loop, \\r is enter, \\b is backspace (default: plays game with fixed guesses)\n"
+            << "  --interval <ms>    delay between keys of active session (default: 100)\n"
+            << "  --duration <s>     how long to run (default: 30)\n"
+            << "  --width <n>, --height <n>  reported window size (default: 80x24)\n";
+    }
+
+    std::string unescape(const std::string& script) {
+        std::string keys;
+        for (std::size_t i = 0; i < script.size(); ++i) {
+            if (script[i] == '\\' && i + 1 < script.size()) {
+                const char escaped = script[++i];
+                keys += escaped == 'r' ? '\r' : escaped == 'n' ? '\n' : escaped == 'e' ? '\033' : escaped == 'b' ? '\177' : escaped;
+            }
+            else { keys += script[i]; }
+        }
+        return keys;
+    }
+
+    bool write_all(const int file_descriptor, const std::string_view bytes) {
+        return write(file_descriptor, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) { print_usage(argv[0]); return EXIT_FAILURE; }
+
+    unsigned long session_count = 100, active_count = 10, interval_ms = 100, duration_s = 30, width = 80, height = 24;
+    std::optional<std::string> keys;
+    for (int i = 2; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sessions") == 0 && has_value) { session_count = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--active") == 0 && has_value) { active_count = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--keys") == 0 && has_value) { keys = unescape(argv[++i]); }
+        else if (std::strcmp(argv[i], "--interval") == 0 && has_value) { interval_ms = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--duration") == 0 && has_value) { duration_s = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--width") == 0 && has_value) { width = std::strtoul(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--height") == 0 && has_value) { height = std::strtoul(argv[++i], nullptr, 10); }
+        else { print_usage(argv[0]); return EXIT_FAILURE; }
+    }
+    if (keys.has_value() && keys->empty()) { keys = "\r"; }
+    if (!keys.has_value()) {
+        /*
+         *  menu -> play, six guesses (all of them in dictionary), back to menu. Keys typed while game is loading
+         *  or tiles are flipping are dropped by the game, so script waits with backspaces (they change nothing on any screen).
+         */
+        const auto wait = [interval_ms](const unsigned long milliseconds) { return std::string(milliseconds / std::max(interval_ms, 1ul) + 1, '\177'); };
+        keys = wait(800) + "\r";
+        for (const char* guess : {"crane", "slate", "point", "mound", "dusty", "fight"}) { keys.value() += guess + ("\r" + wait(2000)); }
+        keys.value() += "q";
+    }
+
+    using namespace Server::Telnet;
+    // client agrees to report window size, and reports it right away
+    const unsigned char window_size[] = {
+        IAC, WILL, OPTION_NAWS,
+        IAC, SB, OPTION_NAWS,
+        static_cast<unsigned char>(width >> 8), static_cast<unsigned char>(width & 0xFF),
+        static_cast<unsigned char>(height >> 8), static_cast<unsigned char>(height & 0xFF),
+        IAC, SE
+    };
+
+    std::vector<ClientSession> sessions(session_count);
+    std::size_t failed_connections = 0;
+    try {
+        const Server::Address address = Server::Address::parse(argv[1]);
+        for (std::size_t i = 0; i < sessions.size(); ++i) {
+            ClientSession& session = sessions[i];
+            try { session.file_descriptor = Server::connectTo(address); }
+            catch (const std::runtime_error& error) {
+                if (failed_connections++ == 0) { std::cerr << error.what() << std::endl; }
+                continue;
+            }
+            Server::setNonBlocking(session.file_descriptor);
+            session.connected = write_all(session.file_descriptor, std::string_view(reinterpret_cast<const char*>(window_size), sizeof(window_size)));
+            session.active = i < active_count;
+        }
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<pollfd> descriptors;
+    for (const ClientSession& session : sessions) {
+        descriptors.push_back(pollfd{session.connected ? session.file_descriptor : -1, POLLIN, 0});
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::seconds(duration_s);
+    const auto interval = std::chrono::milliseconds(interval_ms);
+    auto next_keys = start + interval;
+    std::size_t keys_sent = 0, disconnected = 0;
+    char buffer[16384];
+
+    while (std::chrono::steady_clock::now() < end) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(std::min(next_keys, end) - now).count();
+        const int ready = poll(descriptors.data(), descriptors.size(), static_cast<int>(std::max<long long>(wait, 0)));
+
+        for (std::size_t i = 0; ready > 0 && i < descriptors.size(); ++i) {
+            if (descriptors[i].revents == 0) { continue; }
+            const ssize_t length = read(descriptors[i].fd, buffer, sizeof(buffer));
+            if (length > 0) {
+                sessions[i].received_bytes += length;
+                scan_output(sessions[i], std::string_view(buffer, length));
+            }
+            else if (length == 0 || (errno != EAGAIN && errno != EINTR)) {
+                // server closed session (for example after "Quit" in menu)
+                close(descriptors[i].fd);
+                descriptors[i].fd = -1;
+                sessions[i].connected = false;
+                disconnected++;
+            }
+        }
+
+        // every active session types its next key
+        if (std::chrono::steady_clock::now() >= next_keys) {
+            next_keys += interval;
+            for (ClientSession& session : sessions) {
+                if (!session.active || !session.connected) { continue; }
+                if (write_all(session.file_descriptor, std::string_view(&keys.value()[session.next_key], 1))) { keys_sent++; }
+                session.next_key = (session.next_key + 1) % keys->size();
+            }
+        }
+    }
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::size_t received_bytes = 0, served_sessions = 0, results = 0, unfinished_sessions = 0;
+    for (const ClientSession& session : sessions) {
+        received_bytes += session.received_bytes;
+        results += session.results;
+        if (session.received_bytes > 0) { served_sessions++; }
+        if (session.active && session.file_descriptor >= 0 && session.results == 0) { unfinished_sessions++; }
+    }
+    for (const pollfd& descriptor : descriptors) {
+        if (descriptor.fd >= 0) { close(descriptor.fd); }
+    }
+
+    std::cout
+        << "sessions: " << sessions.size() - failed_connections << " connected (" << failed_connections << " failed), "
+        << served_sessions << " got output, " << disconnected << " closed by server\n"
+        << "keys sent: " << keys_sent << ", games finished: " << results << "\n"
+        << "received: " << received_bytes / 1024 << " KiB (" << static_cast<std::size_t>(received_bytes / 1024 / elapsed) << " KiB/s)\n";
+    if (unfinished_sessions > 0) {
+        std::cerr << unfinished_sessions << " active sessions never reached result screen (keys script doesn't finish a game, or duration is too short)" << std::endl;
+    }
+    return failed_connections == 0 && unfinished_sessions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}